@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "siphash.hpp"
+#include "lookup3.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_HASH_X86 1
+#else
+#define BATCH_HASH_X86 0
+#endif
+
+typedef struct {
+	const void*		data;
+	std::size_t		size;
+} hash_input_t;
+
+/*
+ * Hashes a set of independent payloads at once. On CPUs with AVX2 the
+ * lookup3 payloads are processed in groups of 8, one 32-bit hash state per
+ * vector lane; lanes whose payload has run out of blocks are masked so
+ * they keep their state while the longer payloads in the group finish.
+ * The vector kernel is only used for batches whose payloads are long
+ * enough on average for it to win. SipHash is always hashed one payload
+ * at a time: a 4 lane AVX2 kernel measured no faster than the scalar one
+ * at any payload size. Results are identical to jenkins_hash64_t::hash()
+ * and siphash24() respectively.
+ *
+ * Lanes only run in lockstep for as many blocks as their shortest
+ * payload, so callers get the most out of this by grouping payloads of
+ * similar length; the implementation does not reorder its input.
+ */
+class batch_hash_t
+{
+	private:
+	protected:
+		static void jenkins_scalar(const hash_input_t*, const std::size_t, uint64_t*);
+		static void siphash24_scalar(const hash_input_t*, const std::size_t, const siphash_key_t&, uint64_t*);
+
+#if BATCH_HASH_X86
+		static void jenkins_avx2(const hash_input_t*, const std::size_t, uint64_t*);
+#endif
+
+	public:
+		static const bool avx2(void);
+
+		static void jenkins(const hash_input_t*, const std::size_t, uint64_t*);
+		static void siphash24(const hash_input_t*, const std::size_t, const siphash_key_t&, uint64_t*);
+};
@@ -0,0 +1,221 @@
+#!/bin/sh
+#
+# End-to-end benchmark: generates journals of several sizes with zapgen,
+# rewrites each of them with zap (dropping a field from every entry) and
+# records the per-phase statistics zap reports.
+#
+#   bench.sh run <results file>
+#   bench.sh compare <baseline results> <results>
+#   bench.sh scaling <results file>
+#
+# Results are tab separated, one line per journal size and phase:
+#   entries phase usec objects bytes objects_per_sec bytes_per_sec peak_rss
+# where the "generate" phase is zapgen writing the journal and the others
+# are zap's: map (open and header checks), criteria (resolving -D/-F/-V),
+# rewrite (parse, match and update), write and verify_output. Every run is
+# repeated BENCH_RUNS times and the fastest run of each phase is kept.
+#
+# compare prints every phase of both files side by side and flags those
+# that became more than BENCH_THRESHOLD percent slower (ignoring changes
+# below BENCH_MIN_USEC); the exit status is non-zero if any did.
+#
+# scaling runs the same rewrite, plus a parallel verification (zap -v), of
+# one BENCH_SCALING_ENTRIES entry journal with 1, 2, 4, ... BENCH_THREADS
+# threads (default: all CPUs) and reports each phase's time, speedup over
+# one thread and parallel efficiency (speedup / threads):
+#   threads phase usec speedup efficiency
+# Phases whose efficiency collapses as threads are added are serial.
+
+BENCH_SIZES=${BENCH_SIZES:-"10000 100000 1000000"}
+BENCH_RUNS=${BENCH_RUNS:-3}
+BENCH_DIR=${BENCH_DIR:-/tmp/zap-bench}
+BENCH_THRESHOLD=${BENCH_THRESHOLD:-10}
+BENCH_MIN_USEC=${BENCH_MIN_USEC:-1000}
+BENCH_GEN_ARGS=${BENCH_GEN_ARGS:-"-n 12 -c 5000 -z 1.0 -m 8 -M 256 -b 4"}
+BENCH_SCALING_ENTRIES=${BENCH_SCALING_ENTRIES:-1000000}
+BENCH_THREADS=${BENCH_THREADS:-$(nproc)}
+
+ZAP=${ZAP:-./zap}
+ZAPGEN=${ZAPGEN:-./zapgen}
+
+usage() {
+	echo "Usage: $0 run <results file>" >&2
+	echo "       $0 compare <baseline results> <results>" >&2
+	echo "       $0 scaling <results file>" >&2
+	exit 1
+}
+
+# flatten the phases array of a stats JSON file into result lines
+phases() {
+	tr -d '\n' < "$1" |
+		sed -e 's/.*"phases":\[//' -e 's/\],"counters".*//' -e 's/},{/}\n{/g' |
+		sed -e 's/[{}"]//g' |
+		awk -F, -v entries="$2" '{
+			for (i = 1; i <= NF; i++) {
+				split($i, kv, ":")
+				v[kv[1]] = kv[2]
+			}
+
+			printf("%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n", entries, v["name"], v["usec"], v["objects"],
+				v["bytes"], v["objects_per_sec"], v["bytes_per_sec"], v["peak_rss"])
+		}'
+}
+
+# keep the fastest line of every (first column, phase) pair, in input order
+fastest() {
+	awk -F'\t' '{
+		key = $1 "\t" $2
+
+		if (!(key in best)) {
+			order[n++] = key
+			best[key] = $0
+		} else {
+			split(best[key], b, "\t")
+
+			if ($3 + 0 < b[3] + 0)
+				best[key] = $0
+		}
+	} END {
+		for (i = 0; i < n; i++)
+			print best[order[i]]
+	}' "$1"
+}
+
+run() {
+	results=$1
+	raw=$BENCH_DIR/raw.tsv
+
+	mkdir -p "$BENCH_DIR" || exit 1
+	: > "$raw"
+
+	for entries in $BENCH_SIZES; do
+		journal=$BENCH_DIR/bench-$entries.journal
+		output=$BENCH_DIR/bench-$entries.out.journal
+		run=1
+
+		echo "Benchmarking $entries entries" >&2
+
+		while [ "$run" -le "$BENCH_RUNS" ]; do
+			rm -f "$journal" "$output"
+
+			$ZAPGEN -o "$journal" -e "$entries" $BENCH_GEN_ARGS -J "$BENCH_DIR/gen.json" > /dev/null 2>&1 ||
+				{ echo "zapgen failed for $entries entries" >&2; exit 1; }
+			$ZAP -f "$journal" -o "$output" -D _PID -y -J "$BENCH_DIR/zap.json" > /dev/null 2>&1 ||
+				{ echo "zap failed for $entries entries" >&2; exit 1; }
+
+			phases "$BENCH_DIR/gen.json" "$entries" >> "$raw"
+			phases "$BENCH_DIR/zap.json" "$entries" >> "$raw"
+			run=$((run + 1))
+		done
+
+		rm -f "$journal" "$output"
+	done
+
+	{
+		printf "#entries\tphase\tusec\tobjects\tbytes\tobjects_per_sec\tbytes_per_sec\tpeak_rss\n"
+		fastest "$raw"
+	} > "$results"
+
+	rm -f "$raw" "$BENCH_DIR/gen.json" "$BENCH_DIR/zap.json"
+	cat "$results"
+}
+
+scaling() {
+	results=$1
+	raw=$BENCH_DIR/raw.tsv
+	journal=$BENCH_DIR/scaling.journal
+	output=$BENCH_DIR/scaling.out.journal
+	threads=1
+
+	mkdir -p "$BENCH_DIR" || exit 1
+	: > "$raw"
+	rm -f "$journal"
+
+	$ZAPGEN -o "$journal" -e "$BENCH_SCALING_ENTRIES" $BENCH_GEN_ARGS > /dev/null 2>&1 ||
+		{ echo "zapgen failed for $BENCH_SCALING_ENTRIES entries" >&2; exit 1; }
+
+	while [ "$threads" -le "$BENCH_THREADS" ]; do
+		run=1
+
+		echo "Benchmarking $threads thread(s)" >&2
+
+		while [ "$run" -le "$BENCH_RUNS" ]; do
+			rm -f "$output"
+
+			$ZAP -f "$journal" -o "$output" -D _PID -y -j "$threads" -J "$BENCH_DIR/zap.json" > /dev/null 2>&1 ||
+				{ echo "zap failed with $threads thread(s)" >&2; exit 1; }
+			phases "$BENCH_DIR/zap.json" "$threads" >> "$raw"
+
+			$ZAP -f "$journal" -v -j "$threads" -J "$BENCH_DIR/zap.json" > /dev/null 2>&1 ||
+				{ echo "zap -v failed with $threads thread(s)" >&2; exit 1; }
+			phases "$BENCH_DIR/zap.json" "$threads" >> "$raw"
+
+			run=$((run + 1))
+		done
+
+		# always finish with the full thread count, power of two or not
+		if [ "$threads" -lt "$BENCH_THREADS" ] && [ $((threads * 2)) -gt "$BENCH_THREADS" ]; then
+			threads=$BENCH_THREADS
+		else
+			threads=$((threads * 2))
+		fi
+	done
+
+	{
+		printf "#threads\tphase\tusec\tspeedup\tefficiency\n"
+		fastest "$raw" | awk -F'\t' '{
+			if (1 == $1)
+				base[$2] = $3
+
+			speedup = (0 == $3 || !($2 in base) ? 0 : base[$2] / $3)
+			printf("%s\t%s\t%s\t%.2f\t%.2f\n", $1, $2, $3, speedup, speedup / $1)
+		}'
+	} > "$results"
+
+	rm -f "$raw" "$journal" "$output" "$BENCH_DIR/zap.json"
+	cat "$results"
+}
+
+compare() {
+	awk -F'\t' -v threshold="$BENCH_THRESHOLD" -v floor="$BENCH_MIN_USEC" '
+		BEGIN { printf("%-10s %-14s %12s %12s %8s\n", "#entries", "phase", "base usec", "usec", "change") }
+		/^#/ { next }
+		FNR == NR { base[$1 "\t" $2] = $3; next }
+		{
+			key = $1 "\t" $2
+
+			if (!(key in base)) {
+				printf("%-10s %-14s %12s %12s %8s  new\n", $1, $2, "-", $3, "-")
+				next
+			}
+
+			flag = ""
+			diff = (0 == base[key] ? 0 : ($3 - base[key]) * 100 / base[key])
+
+			if (diff > threshold && $3 - base[key] > floor) {
+				flag = "REGRESSION"
+				regressions++
+			}
+
+			printf("%-10s %-14s %12d %12d %+7.1f%%  %s\n", $1, $2, base[key], $3, diff, flag)
+		}
+		END { exit (regressions > 0) }' "$1" "$2"
+}
+
+case "$1" in
+	run)
+		[ $# -eq 2 ] || usage
+		run "$2"
+		;;
+	compare)
+		[ $# -eq 3 ] || usage
+		compare "$2" "$3"
+		;;
+	scaling)
+		[ $# -eq 2 ] || usage
+		scaling "$2"
+		;;
+	*)
+		usage
+		;;
+esac
@@ -0,0 +1,75 @@
+#include "bitmap.hpp"
+
+bitmap_t::bitmap_t(void)
+	: m_words(nullptr), m_nwords(0), m_nbits(0)
+{
+	return;
+}
+
+bitmap_t::~bitmap_t(void)
+{
+	clear();
+	return;
+}
+
+void
+bitmap_t::resize(const std::size_t nbits)
+{
+	const std::size_t			nwords((nbits + 63) / 64);
+	std::atomic< uint64_t >*	words(nullptr);
+
+	if (nwords == m_nwords) {
+		m_nbits = nbits;
+		return;
+	}
+
+	if (0 != nwords) {
+		words = new std::atomic< uint64_t >[nwords];
+
+		for (std::size_t idx = 0; idx < nwords; idx++)
+			words[idx].store(idx < m_nwords ? m_words[idx].load(std::memory_order_relaxed) : 0, std::memory_order_relaxed);
+	}
+
+	delete[] m_words;
+
+	m_words		= words;
+	m_nwords	= nwords;
+	m_nbits		= nbits;
+	return;
+}
+
+void
+bitmap_t::clear(void)
+{
+	delete[] m_words;
+
+	m_words 	= nullptr;
+	m_nwords	= 0;
+	m_nbits		= 0;
+	return;
+}
+
+const std::size_t
+bitmap_t::size(void) const
+{
+	return m_nbits;
+}
+
+const bool
+bitmap_t::test(const std::size_t bit) const
+{
+	if (bit >= m_nbits)
+		return false;
+
+	return 0 != (m_words[bit / 64].load(std::memory_order_relaxed) & (1ULL << (bit % 64)));
+}
+
+void
+bitmap_t::set(const std::size_t bit)
+{
+	if (bit >= m_nbits)
+		throw std::out_of_range("bitmap_t::set(): bit index out of range");
+
+	m_words[bit / 64].fetch_or(1ULL << (bit % 64), std::memory_order_relaxed);
+	return;
+}
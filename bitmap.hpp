@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <atomic>
+
+#include "exception.hpp"
+
+/*
+ * Fixed-size bitmap safe for concurrent test/set from the decode threads;
+ * bits are only ever set, so relaxed ordering is sufficient.
+ */
+class bitmap_t
+{
+	private:
+		bitmap_t(const bitmap_t&)				= delete;
+		bitmap_t& operator=(const bitmap_t&)	= delete;
+
+	protected:
+		std::atomic< uint64_t >*	m_words;
+		std::size_t					m_nwords;
+		std::size_t					m_nbits;
+
+	public:
+		bitmap_t(void);
+		virtual ~bitmap_t(void);
+
+		virtual void resize(const std::size_t);
+		virtual void clear(void);
+
+		virtual const std::size_t size(void) const;
+		virtual const bool test(const std::size_t) const;
+		virtual void set(const std::size_t);
+};
@@ -0,0 +1,196 @@
+#!/bin/sh
+#
+# Regression checks for the journal writer. Every case generates journals
+# with zapgen, possibly rewrites them with zap, and checks the result with
+# journalctl: --verify, the object counts from --header and the entries
+# found through field matches.
+#
+#   check.sh [case ...]
+#
+# Without arguments every case in CHECK_CASES is run. The exit status is
+# non-zero if any case failed.
+
+CHECK_DIR=${CHECK_DIR:-/tmp/zap-check}
+CHECK_CASES="shared_values dedup buckets entry_arrays growth size hash_table size_dist field_match"
+
+ZAP=${ZAP:-./zap}
+ZAPGEN=${ZAPGEN:-./zapgen}
+JOURNALCTL=${JOURNALCTL:-journalctl}
+
+failures=0
+
+fail() {
+	echo "FAIL: $case: $*" >&2
+	failures=$((failures + 1))
+}
+
+# generate <journal> <zapgen arguments>
+generate() {
+	journal=$1
+	shift
+
+	rm -f "$journal"
+	$ZAPGEN -o "$journal" "$@" > /dev/null 2>&1 || { fail "zapgen $*"; return 1; }
+}
+
+verify() {
+	$JOURNALCTL --verify --file "$1" > /dev/null 2>&1 || fail "$1 does not verify"
+}
+
+# header <journal> <field>: the leading number of a journalctl --header line
+header() {
+	$JOURNALCTL --header --file "$1" | sed -n -e "s/^$2: *//p" | sed -e 's/[^0-9].*//'
+}
+
+# expect <what> <value> <test operator> <expected value>
+expect() {
+	[ "$2" "$3" "$4" ] || fail "$1 is $2, expected $3 $4"
+}
+
+# matches <journal> <field>: journalctl finds exactly the entries that
+# carry the first value of the field through that value
+matches() {
+	value=$($JOURNALCTL --file "$1" -o export | grep -m 1 "^$2=")
+	carried=$($JOURNALCTL --file "$1" -o export | grep -c -x "$value")
+	found=$($JOURNALCTL --file "$1" -o export "$value" | grep -c "^__CURSOR=")
+
+	expect "entries matching $value" "$found" -eq "$carried"
+}
+
+# values used by several entries, each linked into the value's entry arrays
+check_shared_values() {
+	j=$CHECK_DIR/shared_values.journal
+
+	generate "$j" -e 5000 -n 4 -c 3 || return
+	verify "$j"
+	expect "entries" "$(header "$j" "Entry objects")" -eq 5000
+}
+
+# DATA and FIELD objects are written once, however many entries use them
+check_dedup() {
+	j=$CHECK_DIR/dedup.journal
+
+	generate "$j" -e 2000 -n 4 -c 10 || return
+	verify "$j"
+
+	# 4 fields of 10 values each and one _BOOT_ID
+	expect "data objects" "$(header "$j" "Data objects")" -eq 41
+	expect "field objects" "$(header "$j" "Field objects")" -eq 5
+	matches "$j" PRIORITY
+}
+
+# enough values to use every data hash table bucket, the first one included
+check_buckets() {
+	j=$CHECK_DIR/buckets.journal
+
+	generate "$j" -e 20000 -n 12 -c 1000 || return
+	verify "$j"
+
+	# 12 fields of 1000 values each and one _BOOT_ID
+	expect "data objects" "$(header "$j" "Data objects")" -eq 12001
+}
+
+# values shared by so many entries that their entry arrays form long chains
+check_entry_arrays() {
+	j=$CHECK_DIR/entry_arrays.journal
+
+	generate "$j" -e 50000 -n 3 -c 2 || return
+	verify "$j"
+	matches "$j" MESSAGE
+	matches "$j" PRIORITY
+	matches "$j" SYSLOG_IDENTIFIER
+}
+
+# a journal large enough for the arena to grow many times while written
+check_growth() {
+	j=$CHECK_DIR/growth.journal
+	o=$CHECK_DIR/growth.out.journal
+
+	generate "$j" -e 100000 -n 8 -c 500 -m 64 -M 256 || return
+	verify "$j"
+	expect "entries" "$(header "$j" "Entry objects")" -eq 100000
+	matches "$j" _PID
+
+	rm -f "$o"
+	$ZAP -f "$j" -o "$o" -D _PID -y > /dev/null 2>&1 || { fail "zap -D _PID"; return; }
+	verify "$o"
+	expect "rewritten entries" "$(header "$o" "Entry objects")" -eq 100000
+}
+
+# only the part of the arena that holds objects is written out
+check_size() {
+	j=$CHECK_DIR/size.journal
+
+	generate "$j" -e 100 -n 4 -c 10 || return
+	verify "$j"
+
+	expect "file size" "$(stat -c %s "$j")" -eq $(($(header "$j" "Header size") + $(header "$j" "Arena size")))
+	expect "file size" "$(stat -c %s "$j")" -lt 1048576
+}
+
+# the data hash table is sized for the journal, keeping its chains short
+check_hash_table() {
+	j=$CHECK_DIR/hash_table.journal
+	o=$CHECK_DIR/hash_table.out.journal
+
+	generate "$j" -e 20000 -n 12 -c 1000 || return
+	verify "$j"
+	expect "deepest data hash chain" "$(header "$j" "Deepest data hash chain")" -le 8
+
+	rm -f "$o"
+	$ZAP -f "$j" -o "$o" -D _PID -y > /dev/null 2>&1 || { fail "zap -D _PID"; return; }
+	verify "$o"
+	expect "rewritten deepest data hash chain" "$(header "$o" "Deepest data hash chain")" -le 8
+}
+
+# values of skewed sizes, long ones included, written and deduplicated alike
+check_size_dist() {
+	j=$CHECK_DIR/size_dist.journal
+
+	for dist in normal lognormal; do
+		generate "$j" -e 5000 -n 4 -c 10 -m 8 -M 4096 -s $dist || return
+		verify "$j"
+		expect "$dist data objects" "$(header "$j" "Data objects")" -eq 41
+		matches "$j" MESSAGE
+	done
+}
+
+# -F selects the entries holding any value of the field, whichever way
+# the input is read: half of the entries lack _PID after a merge
+check_field_match() {
+	j=$CHECK_DIR/field_match.journal
+	d=$CHECK_DIR/field_match.dropped.journal
+	m=$CHECK_DIR/field_match.merged.journal
+	o=$CHECK_DIR/field_match.out.journal
+
+	generate "$j" -e 2000 -n 4 -c 10 || return
+
+	rm -f "$d" "$m"
+	$ZAP -f "$j" -o "$d" -D _PID -y > /dev/null 2>&1 || { fail "zap -D _PID"; return; }
+	$ZAP -f "$j" -m "$d" -o "$m" -y > /dev/null 2>&1 || { fail "zap -m"; return; }
+
+	for mode in "" -s -X; do
+		rm -f "$o" "$m.zapvidx"
+		$ZAP -f "$m" -o "$o" -F _PID -y $mode > /dev/null 2>&1 || { fail "zap -F _PID $mode"; continue; }
+		verify "$o"
+		expect "entries left by -F _PID $mode" "$(header "$o" "Entry objects")" -eq 2000
+	done
+
+	rm -f "$m.zapvidx"
+}
+
+mkdir -p "$CHECK_DIR" || exit 1
+
+for case in ${*:-$CHECK_CASES}; do
+	echo "Checking $case" >&2
+	check_$case
+done
+
+rm -f "$CHECK_DIR"/*.journal
+
+if [ "$failures" -ne 0 ]; then
+	echo "$failures check(s) failed" >&2
+	exit 1
+fi
+
+echo "All checks passed" >&2
@@ -0,0 +1,172 @@
+#include "cursor.hpp"
+
+entry_cursor_t::entry_cursor_t(const journal_base_t& journal)
+	: m_journal(journal), m_array(nullptr), m_entry(nullptr), m_array_offset(0), 
+	m_array_n_items(0), m_index(0), m_offset(0), m_position(0)
+{
+	return;
+}
+
+entry_cursor_t::~entry_cursor_t(void)
+{
+	return;
+}
+
+void
+entry_cursor_t::reset(void)
+{
+	m_array 		= nullptr;
+	m_entry 		= nullptr;
+	m_array_offset 	= 0;
+	m_array_n_items	= 0;
+	m_index 		= 0;
+	m_offset 		= 0;
+	m_position 		= 0;
+
+	return;
+}
+
+bool
+entry_cursor_t::next_array(void)
+{
+	uint64_t sz(0);
+
+	if (nullptr == m_array)
+		m_array_offset = m_journal.entry_array_offset();
+	else
+		m_array_offset = get_uint64(m_array->entry_array.next_entry_array_offset);
+
+	if (0 == m_array_offset) {
+		m_array = nullptr;
+		return false;
+	}
+
+	DEBUG("entry_cursor_t::next_array(): Moving to entry array at offset: ", to_hex_string(m_array_offset));
+
+	m_array 		= m_journal.object_at(OBJECT_ENTRY_ARRAY, m_array_offset);
+	sz 				= get_uint64(m_array->object.size);
+	m_array_n_items	= (sz - offsetof(entry_array_object_t, items)) / sizeof(uint64_t);
+	m_index 		= 0;
+
+	return true;
+}
+
+bool
+entry_cursor_t::next(void)
+{
+	uint64_t p(0);
+
+	if (m_position >= m_journal.n_entries()) {
+		m_entry = nullptr;
+		return false;
+	}
+
+	/*
+	 * Arrays are allocated with room to spare, so only the first n_entries
+	 * slots across the chain are meaningful; running out of chain before
+	 * that count is reached means the header and the arrays disagree.
+	 */
+	while (nullptr == m_array || m_index >= m_array_n_items) {
+		if (false == next_array())
+			throw journal_verification_error_t("entry_cursor_t::next(): entry array chain shorter than number of entries in header");
+	}
+
+	p = get_uint64(m_array->entry_array.items[m_index]);
+
+	if (0 == p)
+		throw journal_verification_error_t("entry_cursor_t::next(): unused entry array slot encountered before last entry");
+	if (p <= m_offset)
+		throw journal_verification_error_t("entry_cursor_t::next(): entry array not sorted");
+
+	m_entry		= m_journal.object_at(OBJECT_ENTRY, p);
+	m_offset	= p;
+
+	m_index++;
+	m_position++;
+	return true;
+}
+
+const uint64_t
+entry_cursor_t::position(void) const
+{
+	return m_position;
+}
+
+const uint64_t
+entry_cursor_t::offset(void) const
+{
+	return m_offset;
+}
+
+const object_t*
+entry_cursor_t::object(void) const
+{
+	if (nullptr == m_entry)
+		throw journal_invalid_logic_error_t("entry_cursor_t::object(): cursor not positioned on an entry");
+
+	return m_entry;
+}
+
+const uint64_t
+entry_cursor_t::n_items(void) const
+{
+	const uint64_t sz(get_uint64(object()->object.size));
+
+	if (sz < offsetof(entry_object_t, items))
+		return 0;
+
+	return (sz - offsetof(entry_object_t, items)) / sizeof(entry_item_t);
+}
+
+const uint64_t
+entry_cursor_t::item_hash(const uint64_t idx) const
+{
+	if (idx >= n_items())
+		throw journal_parameter_error_t("entry_cursor_t::item_hash(): item index out of range");
+
+	return get_uint64(m_entry->entry.items[idx].hash);
+}
+
+const object_t*
+entry_cursor_t::item(const uint64_t idx) const
+{
+	if (idx >= n_items())
+		throw journal_parameter_error_t("entry_cursor_t::item(): item index out of range");
+
+	return m_journal.object_at(OBJECT_DATA, get_uint64(m_entry->entry.items[idx].object_offset));
+}
+
+std::string
+entry_cursor_t::to_string(void) const
+{
+	return to_string(m_journal, object());
+}
+
+std::string
+entry_cursor_t::to_string(const journal_base_t& journal, const object_t* obj)
+{
+	uint64_t 	sz(0), imax(0);
+	std::string	ret("RT: ");
+
+	if (nullptr == obj || object_type_t::OBJECT_ENTRY != obj->object.type)
+		throw journal_parameter_error_t("entry_cursor_t::to_string(): invalid parameter (nullptr or !OBJECT_ENTRY)");
+
+	sz 		= get_uint64(obj->object.size);
+	imax 	= (sz < offsetof(entry_object_t, items) ? 0 : (sz - offsetof(entry_object_t, items)) / sizeof(entry_item_t));
+
+	ret += to_dec_string(get_uint64(obj->entry.realtime));
+	ret += " MT: ";
+	ret += to_dec_string(get_uint64(obj->entry.monotonic));
+	ret += " BID: ";
+	ret += to_hex_string(get_uint64(obj->entry.boot_id[0]));
+	ret += to_hex_string(get_uint64(obj->entry.boot_id[1]));
+
+	for (uint64_t idx = 0; idx < imax; idx++) {
+		const object_t* data(journal.object_at(OBJECT_DATA, get_uint64(obj->entry.items[idx].object_offset)));
+
+		ret += std::string(reinterpret_cast< const char* >(&data->data.payload[0]), get_uint64(data->object.size) - offsetof(data_object_t, payload));
+		ret += " ";
+	}
+
+	return ret;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "object.hpp"
+#include "journal-def.hpp"
+#include "journal.hpp"
+#include "endian.hpp"
+#include "intstring.hpp"
+#include "log.hpp"
+
+/*
+ * Walks the entries of a journal in sequence number order by following the
+ * entry array chain rooted in the header. Only the current entry array and
+ * entry are referenced at any time and items are resolved on demand, so the
+ * memory used is independent of the number of entries in the file.
+ */
+class entry_cursor_t
+{
+	private:
+	protected:
+		const journal_base_t&	m_journal;
+		const object_t*			m_array;
+		const object_t*			m_entry;
+		uint64_t				m_array_offset;
+		uint64_t				m_array_n_items;
+		uint64_t				m_index;
+		uint64_t				m_offset;
+		uint64_t				m_position;
+
+		virtual bool next_array(void);
+
+	public:
+		entry_cursor_t(const journal_base_t&);
+		virtual ~entry_cursor_t(void);
+
+		virtual void reset(void);
+		virtual bool next(void);
+
+		virtual const uint64_t position(void) const;
+		virtual const uint64_t offset(void) const;
+		virtual const object_t* object(void) const;
+
+		virtual const uint64_t n_items(void) const;
+		virtual const uint64_t item_hash(const uint64_t) const;
+		virtual const object_t* item(const uint64_t) const;
+
+		virtual std::string to_string(void) const;
+		static std::string to_string(const journal_base_t&, const object_t*);
+};
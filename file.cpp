@@ -229,3 +229,31 @@ input_file_t::read(uint8_t* ptr, std::size_t siz)
 
 	return;
 }
+
+uint8_t*
+input_file_t::map(std::size_t siz)
+{
+	void* ptr(nullptr);
+
+	if (true == m_name.empty() || 0 > m_fd)
+		throw std::runtime_error("input_file_t::map(): invalid object state");
+	if (0 == siz || this->size() < siz)
+		throw std::invalid_argument("input_file_t::map(): invalid parameter");
+
+	ptr = ::mmap(nullptr, siz, PROT_READ, MAP_PRIVATE, m_fd, 0);
+
+	if (MAP_FAILED == ptr)
+		throw std::runtime_error("input_file_t::map(): error in mmap(2)");
+
+	return static_cast< uint8_t* >(ptr);
+}
+
+void
+input_file_t::unmap(uint8_t* ptr, std::size_t siz)
+{
+	if (nullptr == ptr || 0 == siz)
+		return;
+
+	(void)::munmap(ptr, siz);
+	return;
+}
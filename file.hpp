@@ -7,6 +7,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 #include "exception.hpp"
 
@@ -34,6 +35,9 @@ class input_file_t
 		virtual std::size_t size(void);
 
 		virtual void read(uint8_t* ptr, std::size_t siz);
+
+		virtual uint8_t* map(std::size_t siz);
+		static void unmap(uint8_t* ptr, std::size_t siz);
 };
 
 class output_file_t
@@ -0,0 +1,126 @@
+#include "filter.hpp"
+
+entry_filter_t::entry_filter_t(void)
+{
+	return;
+}
+
+entry_filter_t::~entry_filter_t(void)
+{
+	return;
+}
+
+hash_filter_t::hash_filter_t(void)
+	: entry_filter_t()
+{
+	return;
+}
+
+hash_filter_t::hash_filter_t(const std::vector< uint64_t >& hashes)
+	: entry_filter_t(), m_hashes(hashes)
+{
+	std::sort(m_hashes.begin(), m_hashes.end());
+	m_hashes.erase(std::unique(m_hashes.begin(), m_hashes.end()), m_hashes.end());
+	return;
+}
+
+hash_filter_t::~hash_filter_t(void)
+{
+	return;
+}
+
+void
+hash_filter_t::add(const uint64_t hash)
+{
+	m_hashes.insert(std::lower_bound(m_hashes.begin(), m_hashes.end(), hash), hash);
+	m_hashes.erase(std::unique(m_hashes.begin(), m_hashes.end()), m_hashes.end());
+	return;
+}
+
+void
+hash_filter_t::add(const std::vector< uint64_t >& hashes)
+{
+	m_hashes.insert(m_hashes.end(), hashes.begin(), hashes.end());
+	std::sort(m_hashes.begin(), m_hashes.end());
+	m_hashes.erase(std::unique(m_hashes.begin(), m_hashes.end()), m_hashes.end());
+	return;
+}
+
+const bool
+hash_filter_t::empty(void) const
+{
+	return m_hashes.empty();
+}
+
+const std::vector< uint64_t >&
+hash_filter_t::hashes(void) const
+{
+	return m_hashes;
+}
+
+const bool
+hash_filter_t::match(const object_t* obj) const
+{
+	uint64_t sz(0), nitems(0);
+
+	if (nullptr == obj || OBJECT_ENTRY != obj->object.type || true == m_hashes.empty())
+		return false;
+
+	sz = get_uint64(obj->object.size);
+
+	if (sz < offsetof(entry_object_t, items))
+		return false;
+
+	nitems = (sz - offsetof(entry_object_t, items)) / sizeof(entry_item_t);
+
+	for (uint64_t idx = 0; idx < nitems; idx++) 
+		if (true == std::binary_search(m_hashes.begin(), m_hashes.end(), get_uint64(obj->entry.items[idx].hash)))
+			return true;
+
+	return false;
+}
+
+seqnum_filter_t::seqnum_filter_t(void)
+	: entry_filter_t()
+{
+	return;
+}
+
+seqnum_filter_t::~seqnum_filter_t(void)
+{
+	return;
+}
+
+void
+seqnum_filter_t::add(const std::vector< uint64_t >& seqnums)
+{
+	m_seqnums.insert(m_seqnums.end(), seqnums.begin(), seqnums.end());
+	std::sort(m_seqnums.begin(), m_seqnums.end());
+	m_seqnums.erase(std::unique(m_seqnums.begin(), m_seqnums.end()), m_seqnums.end());
+	return;
+}
+
+const std::size_t
+seqnum_filter_t::size(void) const
+{
+	return m_seqnums.size();
+}
+
+const bool
+seqnum_filter_t::match(const object_t* obj) const
+{
+	if (nullptr == obj || OBJECT_ENTRY != obj->object.type || true == m_seqnums.empty())
+		return false;
+
+	return std::binary_search(m_seqnums.begin(), m_seqnums.end(), get_uint64(obj->entry.seqnum));
+}
+
+entry_sink_t::entry_sink_t(void)
+{
+	return;
+}
+
+entry_sink_t::~entry_sink_t(void)
+{
+	return;
+}
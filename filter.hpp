@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "global.hpp"
+#include "journal-def.hpp"
+#include "endian.hpp"
+
+class journal_base_t;
+
+/*
+ * Decides whether a raw ENTRY object is selected. Filters only see the
+ * on-disk entry so that they can run while streaming without the entry
+ * being materialized.
+ */
+class entry_filter_t
+{
+	private:
+	protected:
+	public:
+		entry_filter_t(void);
+		virtual ~entry_filter_t(void);
+
+		virtual const bool match(const object_t*) const = 0;
+};
+
+/*
+ * Selects any entry referencing a DATA object whose hash is in the set;
+ * entry items carry the hash of the object they reference, so no item
+ * needs to be resolved.
+ */
+class hash_filter_t : public entry_filter_t
+{
+	private:
+	protected:
+		std::vector< uint64_t >	m_hashes;
+
+	public:
+		hash_filter_t(void);
+		hash_filter_t(const std::vector< uint64_t >&);
+		virtual ~hash_filter_t(void);
+
+		virtual void add(const uint64_t);
+		virtual void add(const std::vector< uint64_t >&);
+		virtual const bool empty(void) const;
+		virtual const std::vector< uint64_t >& hashes(void) const;
+
+		virtual const bool match(const object_t*) const;
+};
+
+/*
+ * Selects entries by sequence number, e.g. as resolved from the postings
+ * of a value_index_t.
+ */
+class seqnum_filter_t : public entry_filter_t
+{
+	private:
+	protected:
+		std::vector< uint64_t >	m_seqnums;
+
+	public:
+		seqnum_filter_t(void);
+		virtual ~seqnum_filter_t(void);
+
+		virtual void add(const std::vector< uint64_t >&);
+		virtual const std::size_t size(void) const;
+
+		virtual const bool match(const object_t*) const;
+};
+
+/*
+ * Receives every entry of a journal in order together with the decision of
+ * the filter it was classified against; the journal is passed along so the
+ * sink can resolve items without the entry having been materialized.
+ */
+class entry_sink_t
+{
+	private:
+	protected:
+	public:
+		entry_sink_t(void);
+		virtual ~entry_sink_t(void);
+
+		virtual void entry(const journal_base_t&, const object_t*, const bool) = 0;
+};
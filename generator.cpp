@@ -0,0 +1,512 @@
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <string.h>
+
+#include "global.hpp"
+#include "output_journal.hpp"
+#include "stats.hpp"
+
+#define MIN_ARGS_COUNT 3
+
+typedef enum
+{
+	SIZE_DIST_UNIFORM = 0,
+	SIZE_DIST_NORMAL,
+	SIZE_DIST_LOGNORMAL,
+	SIZE_DIST_MAX
+} size_dist_t;
+
+/*
+ * The generator shares the journal code with zap and thus its logging,
+ * which only ever consults the debug flag.
+ */
+params_t g_params = params_t();
+
+typedef struct {
+	std::string		output_file;
+	uint64_t		entries;
+	std::size_t		fields;
+	uint64_t		cardinality;
+	double			zipf;
+	std::size_t		min_size;
+	std::size_t		max_size;
+	size_dist_t		size_dist;
+	uint64_t		boots;
+	uint64_t		interval;
+	uint64_t		seed;
+	bool			keyed;
+	std::string		stats_json;
+} gen_params_t;
+
+static gen_params_t gen_params = {
+	std::string(""),
+	100000,
+	8,
+	1000,
+	0.0,
+	16,
+	128,
+	SIZE_DIST_UNIFORM,
+	1,
+	1000000,
+	1,
+	false,
+	std::string("")
+};
+
+/* a realistic set of names first, then numbered ones for wider entries */
+static const char* field_names[] = {
+	"MESSAGE", "PRIORITY", "SYSLOG_IDENTIFIER", "_PID", "_UID", "_GID", "_COMM", "_EXE",
+	"_CMDLINE", "_HOSTNAME", "_TRANSPORT", "_SYSTEMD_UNIT", "_SYSTEMD_CGROUP", "CODE_FILE",
+	"CODE_LINE", "CODE_FUNC"
+};
+
+/* 2024-01-01T00:00:00Z */
+#define GEN_REALTIME_START 1704067200000000ULL
+#define GEN_BOOT_GAP 60000000ULL
+#define GEN_MONOTONIC_START 1000000ULL
+
+/* values of all fields together that are kept rather than generated again */
+#define GEN_PAYLOAD_CACHE (1024 * 1024)
+
+void
+usage(const char* nm)
+{
+	ERROR_NOLINE("Usage: ", nm, " [-o|--output-file] <output file> "		\
+								"[-e|--entries] <count> "					\
+								"[-n|--fields] <count> "					\
+								"[-c|--cardinality] <count> "				\
+								"[-z|--zipf] <exponent> "					\
+								"[-m|--min-size] <bytes> "					\
+								"[-M|--max-size] <bytes> "					\
+								"[-s|--size-dist] <distribution> "			\
+								"[-b|--boots] <count> "						\
+								"[-i|--interval] <usec> "					\
+								"[-r|--seed] <seed> "						\
+								"[-k|--keyed] "								\
+								"[-J|--stats-json] <file> "					\
+								"[-d|--debug]");
+
+	ERROR_NOLINE(" ");
+	ERROR_NOLINE("[-o|--output-file] <output file>    Output journal file (compulsory)");
+	ERROR_NOLINE("[-e|--entries]     <count>          Number of entries (default: 100000)");
+	ERROR_NOLINE("[-n|--fields]      <count>          Fields per entry, besides _BOOT_ID (default: 8)");
+	ERROR_NOLINE("[-c|--cardinality] <count>          Distinct values per field (default: 1000)");
+	ERROR_NOLINE("[-z|--zipf]        <exponent>       Draw values from a Zipf distribution with this exponent (default: 0, uniform)");
+	ERROR_NOLINE("[-m|--min-size]    <bytes>          Minimum value size (default: 16)");
+	ERROR_NOLINE("[-M|--max-size]    <bytes>          Maximum value size (default: 128)");
+	ERROR_NOLINE("[-s|--size-dist]   <distribution>   Distribution of value sizes between the minimum and maximum:");
+	ERROR_NOLINE("                                    uniform, normal or lognormal (default: uniform)");
+	ERROR_NOLINE("[-b|--boots]       <count>          Number of boots the entries are spread over (default: 1)");
+	ERROR_NOLINE("[-i|--interval]    <usec>           Time between consecutive entries (default: 1000000)");
+	ERROR_NOLINE("[-r|--seed]        <seed>           Random seed; equal seeds produce equal journals (default: 1)");
+	ERROR_NOLINE("[-k|--keyed]                        Use keyed (siphash) data hashes");
+	ERROR_NOLINE("[-J|--stats-json]  <file>           Write generation statistics to a file as JSON");
+	ERROR_NOLINE("[-d|--debug]                        Enable debugging");
+
+	_exit(EXIT_FAILURE);
+	return;
+}
+
+void
+parse_arguments(signed int ac, char** av)
+{
+	std::size_t cnt(static_cast< std::size_t >(ac));
+	std::string dist("");
+
+	if (0 > ac) {
+		throw std::runtime_error("::parse_arguments(): invalid/impossible negative argc encountered");
+		_exit(EXIT_FAILURE);
+	}
+
+	if (MIN_ARGS_COUNT > ac)
+		usage(av[0]);
+
+	for (std::size_t idx = 1; idx < cnt; idx++) {
+		if (! ::strncmp("-o", av[idx], ::strlen("-o")) || ! ::strncmp("--output-file", av[idx], ::strlen("--output-file"))) {
+			if (true != gen_params.output_file.empty() || idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.output_file = av[++idx];
+
+		} else if (! ::strncmp("-e", av[idx], ::strlen("-e")) || ! ::strncmp("--entries", av[idx], ::strlen("--entries"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.entries = std::strtoull(av[++idx], nullptr, 10);
+
+		} else if (! ::strncmp("-n", av[idx], ::strlen("-n")) || ! ::strncmp("--fields", av[idx], ::strlen("--fields"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.fields = static_cast< std::size_t >(std::strtoul(av[++idx], nullptr, 10));
+
+		} else if (! ::strncmp("-c", av[idx], ::strlen("-c")) || ! ::strncmp("--cardinality", av[idx], ::strlen("--cardinality"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.cardinality = std::strtoull(av[++idx], nullptr, 10);
+
+		} else if (! ::strncmp("-z", av[idx], ::strlen("-z")) || ! ::strncmp("--zipf", av[idx], ::strlen("--zipf"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.zipf = std::strtod(av[++idx], nullptr);
+
+		} else if (! ::strncmp("-m", av[idx], ::strlen("-m")) || ! ::strncmp("--min-size", av[idx], ::strlen("--min-size"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.min_size = static_cast< std::size_t >(std::strtoul(av[++idx], nullptr, 10));
+
+		} else if (! ::strncmp("-M", av[idx], ::strlen("-M")) || ! ::strncmp("--max-size", av[idx], ::strlen("--max-size"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.max_size = static_cast< std::size_t >(std::strtoul(av[++idx], nullptr, 10));
+
+		} else if (! ::strncmp("-s", av[idx], ::strlen("-s")) || ! ::strncmp("--size-dist", av[idx], ::strlen("--size-dist"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			dist = av[++idx];
+
+			if ("uniform" == dist)
+				gen_params.size_dist = SIZE_DIST_UNIFORM;
+			else if ("normal" == dist)
+				gen_params.size_dist = SIZE_DIST_NORMAL;
+			else if ("lognormal" == dist)
+				gen_params.size_dist = SIZE_DIST_LOGNORMAL;
+			else {
+				ERROR_NOLINE("Invalid size distribution: ", dist);
+				usage(av[0]);
+			}
+
+		} else if (! ::strncmp("-b", av[idx], ::strlen("-b")) || ! ::strncmp("--boots", av[idx], ::strlen("--boots"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.boots = std::strtoull(av[++idx], nullptr, 10);
+
+		} else if (! ::strncmp("-i", av[idx], ::strlen("-i")) || ! ::strncmp("--interval", av[idx], ::strlen("--interval"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.interval = std::strtoull(av[++idx], nullptr, 10);
+
+		} else if (! ::strncmp("-r", av[idx], ::strlen("-r")) || ! ::strncmp("--seed", av[idx], ::strlen("--seed"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.seed = std::strtoull(av[++idx], nullptr, 10);
+
+		} else if (! ::strncmp("-k", av[idx], ::strlen("-k")) || ! ::strncmp("--keyed", av[idx], ::strlen("--keyed"))) {
+			gen_params.keyed = true;
+
+		} else if (! ::strncmp("-J", av[idx], ::strlen("-J")) || ! ::strncmp("--stats-json", av[idx], ::strlen("--stats-json"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			gen_params.stats_json = av[++idx];
+
+		} else if (! ::strncmp("-d", av[idx], ::strlen("-d")) || ! ::strncmp("--debug", av[idx], ::strlen("--debug"))) {
+			g_params.debug = true;
+
+		} else {
+			ERROR_NOLINE("Invalid parameter: ", av[idx]);
+			usage(av[0]);
+		}
+	}
+
+	if (true == gen_params.output_file.empty()) {
+		ERROR_NOLINE("No output file specified");
+		usage(av[0]);
+	}
+
+	if (0 == gen_params.entries || 0 == gen_params.fields || 0 == gen_params.cardinality || 0 == gen_params.boots ||
+		0 == gen_params.interval || 0 == gen_params.min_size || gen_params.min_size > gen_params.max_size || 0 > gen_params.zipf) {
+		ERROR_NOLINE("Invalid generator parameters");
+		usage(av[0]);
+	}
+
+	return;
+}
+
+/*
+ * splitmix64; used to derive everything about a value from its field and
+ * index so that the same value always yields the same payload.
+ */
+static inline uint64_t
+mix(uint64_t x)
+{
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+class value_sampler_t
+{
+	private:
+		value_sampler_t(const value_sampler_t&)				= delete;
+		value_sampler_t& operator=(const value_sampler_t&)	= delete;
+
+	protected:
+		std::mt19937_64							m_rng;
+		std::uniform_int_distribution< uint64_t >	m_uniform;
+		std::uniform_real_distribution< double >	m_real;
+		std::vector< double >					m_cdf;
+
+	public:
+		value_sampler_t(const uint64_t seed, const uint64_t cardinality, const double exponent)
+			: m_rng(seed), m_uniform(0, cardinality - 1), m_real(0.0, 1.0)
+		{
+			double sum(0.0);
+
+			if (0.0 == exponent)
+				return;
+
+			m_cdf.resize(cardinality);
+
+			for (uint64_t idx = 0; idx < cardinality; idx++) {
+				sum 		+= 1.0 / std::pow(static_cast< double >(idx + 1), exponent);
+				m_cdf[idx] 	= sum;
+			}
+
+			for (uint64_t idx = 0; idx < cardinality; idx++)
+				m_cdf[idx] /= sum;
+
+			return;
+		}
+
+		virtual ~value_sampler_t(void)
+		{
+			return;
+		}
+
+		virtual uint64_t
+		next(void)
+		{
+			std::vector< double >::const_iterator itr;
+
+			if (true == m_cdf.empty())
+				return m_uniform(m_rng);
+
+			itr = std::lower_bound(m_cdf.begin(), m_cdf.end(), m_real(m_rng));
+
+			if (itr == m_cdf.end())
+				return m_cdf.size() - 1;
+
+			return static_cast< uint64_t >(itr - m_cdf.begin());
+		}
+
+		virtual uint64_t
+		random(void)
+		{
+			return m_rng();
+		}
+};
+
+/* a double in (0, 1] from the top 53 bits of a hash */
+static inline double
+unit(const uint64_t x)
+{
+	return static_cast< double >((x >> 11) + 1) / 9007199254740992.0;
+}
+
+/*
+ * The size of a value, drawn from the configured distribution by the hash
+ * of the value so that it does not depend on the order values are drawn
+ * in. Normal sizes centre between the minimum and the maximum with the
+ * bounds three standard deviations out; lognormal sizes have their median
+ * at the geometric mean of the bounds, so most values are short with a
+ * long tail towards the maximum, as messages in real journals are. Either
+ * is clamped to the bounds.
+ */
+static std::size_t
+payload_size(const uint64_t state)
+{
+	const std::size_t	span(gen_params.max_size - gen_params.min_size + 1);
+	const double		lo(static_cast< double >(gen_params.min_size));
+	const double		hi(static_cast< double >(gen_params.max_size));
+	double				z(0.0), len(0.0);
+
+	if (SIZE_DIST_UNIFORM == gen_params.size_dist)
+		return gen_params.min_size + static_cast< std::size_t >(state % span);
+
+	/* Box-Muller */
+	z = std::sqrt(-2.0 * std::log(unit(mix(state)))) * std::cos(2.0 * M_PI * unit(mix(mix(state))));
+
+	if (SIZE_DIST_NORMAL == gen_params.size_dist)
+		len = (lo + hi) / 2.0 + z * (hi - lo) / 6.0;
+	else
+		len = std::exp((std::log(lo) + std::log(hi)) / 2.0 + z * (std::log(hi) - std::log(lo)) / 6.0);
+
+	len = std::round(len);
+
+	if (len < lo)
+		return gen_params.min_size;
+	if (len > hi)
+		return gen_params.max_size;
+
+	return static_cast< std::size_t >(len);
+}
+
+static void
+make_payload(const std::string& name, const std::size_t field, const uint64_t value, std::string& dst)
+{
+	static const char	alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+	uint64_t			state(mix(gen_params.seed ^ mix((static_cast< uint64_t >(field) << 40) ^ value)));
+	const std::size_t	len(payload_size(state));
+	const std::size_t	hdr(name.length() + 1);
+
+	dst.resize(hdr + len);
+	std::memcpy(&dst[0], name.data(), name.length());
+	dst[name.length()] = '=';
+
+	for (std::size_t idx = 0; idx < len; idx++) {
+		if (0 == idx % 8)
+			state = mix(state);
+
+		dst[hdr + idx] = alphabet[((state >> ((idx % 8) * 8)) & 0xFF) % (sizeof(alphabet) - 1)];
+	}
+
+	return;
+}
+
+/* sd_id128_to_string(): the 16 bytes of the id, in memory order */
+static std::string
+id128_string(const uint128_vec_t& id)
+{
+	const uint8_t*	ptr(reinterpret_cast< const uint8_t* >(id.data()));
+	std::string		str("");
+
+	for (std::size_t idx = 0; idx < 16; idx++)
+		str += to_hex_string(ptr[idx]);
+
+	return str;
+}
+
+signed int
+main(signed int ac, char** av)
+{
+	output_journal_t			oj;
+	stats_t						stats;
+	std::vector< std::string >	names;
+	std::vector< std::string >	values;
+	std::vector< std::string >	cache;
+	std::vector< hash_input_t >	payloads;
+	std::string					boot_field;
+	uint128_vec_t				boot_id = {{ 0, 0 }};
+	uint64_t					realtime(GEN_REALTIME_START), monotonic(GEN_MONOTONIC_START);
+	uint64_t					per_boot(0);
+
+	parse_arguments(ac, av);
+
+	try {
+		value_sampler_t sampler(gen_params.seed, gen_params.cardinality, gen_params.zipf);
+		uint128_vec_t	id = {{ 0, 0 }};
+
+		for (std::size_t idx = 0; idx < gen_params.fields; idx++) {
+			if (idx < sizeof(field_names) / sizeof(field_names[0]))
+				names.push_back(field_names[idx]);
+			else
+				names.push_back("FIELD_" + std::to_string(idx));
+		}
+
+		values.resize(gen_params.fields);
+		payloads.resize(gen_params.fields + 1);
+
+		/*
+		 * Values recur all the time at any realistic cardinality, so unless
+		 * there are too many of them each is generated once and kept.
+		 */
+		if (gen_params.cardinality <= GEN_PAYLOAD_CACHE / gen_params.fields)
+			cache.resize(gen_params.fields * gen_params.cardinality);
+
+		oj.name(gen_params.output_file.c_str());
+		oj.header_size(sizeof(header_contents_t));
+		oj.state(STATE_OFFLINE);
+		oj.incompatible_flags(true == gen_params.keyed ? HEADER_INCOMPATIBLE_KEYED_HASH : 0);
+
+		id[0] = sampler.random(); id[1] = sampler.random();
+		oj.file_id(id);
+		id[0] = sampler.random(); id[1] = sampler.random();
+		oj.machine_id(id);
+		id[0] = sampler.random(); id[1] = sampler.random();
+		oj.seqnum_id(id);
+
+		/* a rough estimate of the final size, used to size the data hash table */
+		oj.size_hint(gen_params.entries * gen_params.fields * (gen_params.min_size + gen_params.max_size) / 2);
+
+		INFO("Generating ", gen_params.entries, " entries of ", gen_params.fields, " fields into ", gen_params.output_file);
+		stats.begin("generate");
+
+		oj.begin_write();
+
+		per_boot = DIV_ROUND_UP(gen_params.entries, gen_params.boots);
+
+		for (uint64_t entry = 0; entry < gen_params.entries; entry++) {
+			if (0 == entry % per_boot) {
+				boot_id[0] 	= sampler.random();
+				boot_id[1] 	= sampler.random();
+				monotonic 	= GEN_MONOTONIC_START;
+				boot_field 	= "_BOOT_ID=" + id128_string(boot_id);
+
+				payloads[gen_params.fields].data = boot_field.data();
+				payloads[gen_params.fields].size = boot_field.length();
+
+				if (0 != entry)
+					realtime += GEN_BOOT_GAP;
+			}
+
+			for (std::size_t idx = 0; idx < gen_params.fields; idx++) {
+				const uint64_t	value(sampler.next());
+				std::string*	payload(&values[idx]);
+
+				if (false == cache.empty()) {
+					payload = &cache[idx * gen_params.cardinality + value];
+
+					if (true == payload->empty())
+						make_payload(names[idx], idx, value, *payload);
+				} else
+					make_payload(names[idx], idx, value, *payload);
+
+				payloads[idx].data = payload->data();
+				payloads[idx].size = payload->length();
+			}
+
+			oj.write_entry(realtime, monotonic, boot_id, payloads.data(), payloads.size());
+
+			realtime 	+= gen_params.interval;
+			monotonic 	+= gen_params.interval;
+		}
+
+		oj.boot_id(boot_id);
+		oj.end_write();
+		stats.end(oj.n_objects(), oj.header_size() + oj.arena_size());
+
+		stats.counter("entries", oj.n_entries());
+		stats.counter("objects", oj.n_objects());
+		stats.counter("data_objects", oj.n_data());
+		stats.counter("field_objects", oj.n_fields());
+		stats.counter("file_size", oj.header_size() + oj.arena_size());
+		stats.print();
+
+		if (false == gen_params.stats_json.empty() && false == stats.write_json(gen_params.stats_json))
+			ERROR("Unable to write statistics: ", gen_params.stats_json);
+
+	} catch (std::exception& e) {
+		ERROR(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -27,11 +27,25 @@ typedef struct {
     std::string 				output_file;
     std::vector< std::string > 	fields;
 	std::vector< std::string >  field_values;
+	std::vector< std::string >	drop_fields;
     bool 						print_all;
     bool 						print_matches;
     bool 						confirm_matches;
     bool 						yes;
     bool 						debug;
+	bool						stream;
+	std::size_t					threads;
+	bool						index;
+	bool						value_index;
+	bool						strict;
+	std::string					verify_level;
+	bool						verify_only;
+	bool						timings;
+	std::string					stats_json;
+	std::string					trace_file;
+	bool						counters;
+	std::string					sort_order;
+	std::vector< std::string >	merge_files;
 } params_t;
 
 
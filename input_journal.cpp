@@ -1,13 +1,13 @@
 #include "input_journal.hpp"
 
 input_journal_t::input_journal_t(void)
-	: journal_base_t(), m_parsed(false)
+	: journal_base_t(), m_parsed(false), m_mapped(false), m_threads(0), m_verify_level(VERIFY_FULL)
 {
 	return;
 }
 
 input_journal_t::input_journal_t(const char* name)
-	: journal_base_t(name), m_parsed(false)
+	: journal_base_t(name), m_parsed(false), m_mapped(false), m_threads(0), m_verify_level(VERIFY_FULL)
 {
 	return;
 }
@@ -19,197 +19,227 @@ input_journal_t::~input_journal_t(void)
 }
 
 void
-input_journal_t::verify_file(const header_contents_t* hdr) const
+input_journal_t::verify_step(verify_state_t& st, const uint64_t off, const object_t* obj) const
 {
-	uint64_t 		off(m_header_size);
-	object_t*		obj(nullptr);
-	uint64_t		nobjects(0), nfields(0), ntags(0), nentries(0), ndata_hash_tables(0), nfield_hash_tables(0);
-	uint64_t		nentry_arrays(0), ndata(0);
-	uint64_t		last_tag_realtime(0), entry_seqnum(0), entry_monotonic(0), entry_realtime(0), last_tag(0), last_epoch(0);
-	bool			entry_seqnum_set(false), entry_monotonic_set(false), entry_realtime_set(false);
-	bool			found_main_entry_array(false), found_last(false);
-	uint128_vec_t	entry_boot_id({0,0});
+	if (nullptr == obj)
+		throw journal_parameter_error_t("input_journal_t::verify_step(): invalid parameter encountered (nullptr)");
 
+	if (off > m_tail_object_offset)
+		throw journal_verification_error_t("input_journal_t::verify_step(): invalid tail object offset encountered");
 
-	if (nullptr == hdr)
-		throw journal_parameter_error_t("input_journal_t::verify_file(): invalid parameter encountered (nullptr)");
+	st.nobjects++;
+	DEBUG("Found Object of Type:          ", object_type_string(obj->object.type), " (", object_flags_string(obj->object.flags), ")");
+	DEBUG("Verifying Object #:            ", to_dec_string(st.nobjects), " (", to_dec_string(m_n_objects), ")");
 
-	DEBUG("Verifying all objects...");
+	if (1 <
+		!!(obj->object.flags & OBJECT_COMPRESSED_XZ) +
+		!!(obj->object.flags & OBJECT_COMPRESSED_LZ4) +
+		!!(obj->object.flags & OBJECT_COMPRESSED_ZSTD))
+			throw journal_verification_error_t("input_journal_t::verify_step(): object has multiple compression type flags specified");
 
-	for (;;) {
-		DEBUG("Moving to offset:              ", to_dec_string(off), " (", to_dec_string(m_tail_object_offset), ")");
-		move_to_object(object_type_t::OBJECT_UNUSED, off, &obj);
+	if ((obj->object.flags & OBJECT_COMPRESSED_XZ) && !(IS_HEADER_INCOMPATIBLE_COMPRESSED_XZ(m_incompatible_flags)))
+		throw journal_verification_error_t("input_journal_t::verify_step(): XZ compressed object encountered in file lacking XZ compression");
 
-		if (off > m_tail_object_offset)
-			throw journal_verification_error_t("input_journal_t::verify_file(): invalid tail object offset encountered");
+	if ((obj->object.flags & OBJECT_COMPRESSED_LZ4) && !(IS_HEADER_INCOMPATIBLE_COMPRESSED_LZ4(m_incompatible_flags)))
+		throw journal_verification_error_t("input_journal_t::verify_step(): LZ4 compressed object encountered in file lacking LZ4 compression");
 
-		nobjects++;
-		DEBUG("Found Object of Type:          ", obj_hdr_t::type_string(obj->object.type), " (", obj_hdr_t::flags_string(obj->object.flags), ")");
-		DEBUG("Verifying Object #:            ", to_dec_string(nobjects), " (", to_dec_string(m_n_objects), ")");
+	if ((obj->object.flags & OBJECT_COMPRESSED_ZSTD) && !(IS_HEADER_INCOMPATIBLE_COMPRESSED_ZSTD(m_incompatible_flags)))
+		throw journal_verification_error_t("input_journal_t::verify_step(): ZSTD compressed object encountered in file lacking ZSTD compression");
 
-		verify_object(off, obj);
+	switch (obj->object.type) {
+		case object_type_t::OBJECT_DATA:
+			st.ndata++;
+		break;
+	
+		case object_type_t::OBJECT_FIELD:
+			st.nfields++;
+		break;
 
-		if (1 <
-			!!(obj->object.flags & OBJECT_COMPRESSED_XZ) +
-			!!(obj->object.flags & OBJECT_COMPRESSED_LZ4) +
-			!!(obj->object.flags & OBJECT_COMPRESSED_ZSTD))
-				throw journal_verification_error_t("input_journal_t::verify_file(): object has multiple compression type flags specified");
+		case object_type_t::OBJECT_ENTRY:
+			if (IS_HEADER_COMPATIBLE_SEALED(m_compatible_flags) && 0 == m_n_tags)
+				throw journal_verification_error_t("input_journal_t::verify_step(): encountered entry prior to first tag");
 
-		if ((obj->object.flags & OBJECT_COMPRESSED_XZ) && !(IS_HEADER_INCOMPATIBLE_COMPRESSED_XZ(m_incompatible_flags)))
-			throw journal_verification_error_t("input_journal_t::verify_file(): XZ compressed object encountered in file lacking XZ compression");
+			if (get_uint64(obj->entry.realtime) < st.last_tag_realtime)
+				throw journal_verification_error_t("input_journal_t::verify_step(): older entry after new tag encountered");
 
-		if ((obj->object.flags & OBJECT_COMPRESSED_LZ4) && !(IS_HEADER_INCOMPATIBLE_COMPRESSED_LZ4(m_incompatible_flags)))
-			throw journal_verification_error_t("input_journal_t::verify_file(): LZ4 compressed object encountered in file lacking LZ4 compression");
+			if (! st.entry_seqnum_set && get_uint64(obj->entry.seqnum) != m_head_entry_seqnum)
+				throw journal_verification_error_t("input_journal_t::verify_step(): head sequence number incorrect");
 
-		if ((obj->object.flags & OBJECT_COMPRESSED_ZSTD) && !(IS_HEADER_INCOMPATIBLE_COMPRESSED_ZSTD(m_incompatible_flags)))
-			throw journal_verification_error_t("input_journal_t::verify_file(): ZSTD compressed object encountered in file lacking ZSTD compression");
+			if (true == st.entry_seqnum_set && st.entry_seqnum >= get_uint64(obj->entry.seqnum))
+				throw journal_verification_error_t("input_journal_t::verify_step(): entry sequence number out of synchronization");
 
-		switch (obj->object.type) {
-			case object_type_t::OBJECT_DATA:
-				ndata++;
-			break;
-		
-			case object_type_t::OBJECT_FIELD:
-				nfields++;
-			break;
+			st.entry_seqnum		= get_uint64(obj->entry.seqnum);
+			st.entry_seqnum_set	= true;
 
-			case object_type_t::OBJECT_ENTRY:
-				if (IS_HEADER_COMPATIBLE_SEALED(m_compatible_flags) && 0 == m_n_tags)
-					throw journal_verification_error_t("input_journal_t::verify_file(): encountered entry prior to first tag");
+			if (true == st.entry_monotonic_set && st.entry_boot_id[0] == get_uint64(obj->entry.boot_id[0]) &&
+				st.entry_boot_id[1] == get_uint64(obj->entry.boot_id[1]) && st.entry_monotonic > get_uint64(obj->entry.monotonic)) 
+				throw journal_verification_error_t("input_journal_t::verify_step(): entry timestamp out of synchronization");
 
-				if (get_uint64(obj->entry.realtime) < last_tag_realtime)
-					throw journal_verification_error_t("input_journal_t::verify_file(): older entry after new tag encountered");
+			st.entry_monotonic		= get_uint64(obj->entry.monotonic);
+			st.entry_boot_id[0]	= get_uint64(obj->entry.boot_id[0]);
+			st.entry_boot_id[1]	= get_uint64(obj->entry.boot_id[1]);
+			st.entry_monotonic_set	= true;
 
-				if (! entry_seqnum_set && get_uint64(obj->entry.seqnum) != m_head_entry_seqnum)
-					throw journal_verification_error_t("input_journal_t::verify_file(): head sequence number incorrect");
+			if (! st.entry_realtime_set && get_uint64(obj->entry.realtime) != m_head_entry_realtime)
+				throw journal_verification_error_t("input_journal_t::verify_step(): head entry timestamp incorrect");
 
-				if (true == entry_seqnum_set && entry_seqnum >= get_uint64(obj->entry.seqnum))
-					throw journal_verification_error_t("input_journal_t::verify_file(): entry sequence number out of synchronization");
+			st.entry_realtime		= get_uint64(obj->entry.realtime);
+			st.entry_realtime_set	= true;
 
-				entry_seqnum		= get_uint64(obj->entry.seqnum);
-				entry_seqnum_set	= true;
+			st.nentries++;
+		break;
 
-				if (true == entry_monotonic_set && entry_boot_id[0] == get_uint64(obj->entry.boot_id[0]) &&
-					entry_boot_id[1] == get_uint64(obj->entry.boot_id[1]) && entry_monotonic > get_uint64(obj->entry.monotonic)) 
-					throw journal_verification_error_t("input_journal_t::verify_file(): entry timestamp out of synchronization");
+		case object_type_t::OBJECT_DATA_HASH_TABLE:
+			if (1 < st.ndata_hash_tables)
+				throw journal_verification_error_t("input_journal_t::verify_step(): invalid number of data hash tables encountered (>1)");
 
-				entry_monotonic		= get_uint64(obj->entry.monotonic);
-				entry_boot_id[0]	= get_uint64(obj->entry.boot_id[0]);
-				entry_boot_id[1]	= get_uint64(obj->entry.boot_id[1]);
-				entry_monotonic_set	= true;
+			if ((m_data_hash_table_offset != off + offsetof(hash_table_object_t, items)) ||
+				(m_data_hash_table_size != get_uint64(obj->object.size) - offsetof(hash_table_object_t, items)))
+				throw journal_verification_error_t("input_journal_t::verify_step(): invalid header fields for data hash table encountered");
 
-				if (! entry_realtime_set && get_uint64(obj->entry.realtime) != m_head_entry_realtime)
-					throw journal_verification_error_t("input_journal_t::verify_file(): head entry timestamp incorrect");
+			st.ndata_hash_tables++;
 
-				entry_realtime		= get_uint64(obj->entry.realtime);
-				entry_realtime_set	= true;
+		break;
 
-				nentries++;
-			break;
+		case object_type_t::OBJECT_FIELD_HASH_TABLE:
+			if (1 < st.nfield_hash_tables)
+				throw journal_verification_error_t("input_journal_t::verify_step(): invalid number of field hash tables encountered (>1)");
 
-			case object_type_t::OBJECT_DATA_HASH_TABLE:
-				if (1 < ndata_hash_tables)
-					throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of data hash tables encountered (>1)");
+			if ((m_field_hash_table_offset != off + offsetof(hash_table_object_t, items)) ||
+				(m_field_hash_table_size != get_uint64(obj->object.size) - offsetof(hash_table_object_t, items)))
+				throw journal_verification_error_t("input_journal_t::verify_step(): invalid header fields for field hash table encountered");
 
-				if ((m_data_hash_table_offset != off + offsetof(hash_table_object_t, items)) ||
-					(m_data_hash_table_size != get_uint64(obj->object.size) - offsetof(hash_table_object_t, items)))
-					throw journal_verification_error_t("input_journal_t::verify_file(): invalid header fields for data hash table encountered");
+			st.nfield_hash_tables++;
+		break;
 
-				ndata_hash_tables++;
+		case object_type_t::OBJECT_ENTRY_ARRAY:
+			if (off == m_entry_array_offset) {
+				if (true == st.found_main_entry_array)
+					throw journal_verification_error_t("input_journal_t::verify_step(): invalid number of main entry arrays encountered (>1)");
+				
+				st.found_main_entry_array = true;
+			}
 
-			break;
+			st.nentry_arrays++;
+		break;
 
-			case object_type_t::OBJECT_FIELD_HASH_TABLE:
-				if (1 < nfield_hash_tables)
-					throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of field hash tables encountered (>1)");
+		case object_type_t::OBJECT_TAG:
+			if (! IS_HEADER_COMPATIBLE_SEALED(m_compatible_flags))
+				throw journal_verification_error_t("input_journal_t::verify_step(): tag object encountered in unsealed file");
 
-				if ((m_field_hash_table_offset != off + offsetof(hash_table_object_t, items)) ||
-					(m_field_hash_table_size != get_uint64(obj->object.size) - offsetof(hash_table_object_t, items)))
-					throw journal_verification_error_t("input_journal_t::verify_file(): invalid header fields for field hash table encountered");
+			if (get_uint64(obj->tag.seqnum) != st.ntags+1)
+				throw journal_verification_error_t("input_journal_t::verify_step(): tag sequence numbers out of synchronization");
 
-				nfield_hash_tables++;
-			break;
+			if (get_uint64(obj->tag.epoch) < st.last_epoch)
+				throw journal_verification_error_t("input_journal_t::verify_step(): tag epoch sequence numbers out of synchronization");
+		
+			if (true == m_seal)
+				throw journal_verification_error_t("input_journal_t::verify_step(): sealing semantics not yet implemented");
 
-			case object_type_t::OBJECT_ENTRY_ARRAY:
-				if (off == m_entry_array_offset) {
-					if (true == found_main_entry_array)
-						throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of main entry arrays encountered (>1)");
-					
-					found_main_entry_array = true;
-				}
+			st.last_tag    = off + ALIGN64(get_uint64(obj->object.size));
+			st.last_epoch  = get_uint64(obj->tag.epoch);
+			
+			st.ntags++;
+		break;
 
-				nentry_arrays++;
-			break;
+		default:
+			throw journal_verification_error_t("input_journal_t::verify_step(): invalid/unknown object type encountered");
+		break;
+	}
 
-			case object_type_t::OBJECT_TAG:
-				if (! IS_HEADER_COMPATIBLE_SEALED(m_compatible_flags))
-					throw journal_verification_error_t("input_journal_t::verify_file(): tag object encountered in unsealed file");
+	if (off == m_tail_object_offset)
+		st.found_last = true;
 
-				if (get_uint64(obj->tag.seqnum) != ntags+1)
-					throw journal_verification_error_t("input_journal_t::verify_file(): tag sequence numbers out of synchronization");
+	return;
+}
 
-				if (get_uint64(obj->tag.epoch) < last_epoch)
-					throw journal_verification_error_t("input_journal_t::verify_file(): tag epoch sequence numbers out of synchronization");
-			
-				if (true == m_seal)
-					throw journal_verification_error_t("input_journal_t::verify_file(): sealing semantics not yet implemented");
+void
+input_journal_t::verify_finish(verify_state_t& st, const header_contents_t* hdr) const
+{
+	if (nullptr == hdr)
+		throw journal_parameter_error_t("input_journal_t::verify_finish(): invalid parameter encountered (nullptr)");
 
-				last_tag    = off + ALIGN64(get_uint64(obj->object.size));
-				last_epoch  = get_uint64(obj->tag.epoch);
-				
-				ntags++;
-			break;
+	// XXX JNF
+	st.last_tag++;
 
-			default:
-				throw journal_verification_error_t("input_journal_t::verify_file(): invalid/unknown object type encountered");
-			break;
-		}
+	if (! st.found_last && 0 != m_tail_object_offset)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid tail object pointer encountered");
 
-		if (off == m_tail_object_offset) {
-			found_last = true;
-			break;
-		}
+	if (st.nobjects != m_n_objects)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid number of objects encountered");
 
-		off += ALIGN64(get_uint64(obj->object.size));
-	}
+	if (st.nentries != m_n_entries)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid number of entries encountered");
 
-	// XXX JNF
-	last_tag++;
+	if (JOURNAL_HEADER_CONTAINS(hdr, n_data) && st.ndata != m_n_data)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid number of data entries encountered");
+
+	if (JOURNAL_HEADER_CONTAINS(hdr, n_fields) && st.nfields != m_n_fields)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid number of fields encountered");
 
-	if (! found_last && 0 != m_tail_object_offset)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid tail object pointer encountered");
+	if (JOURNAL_HEADER_CONTAINS(hdr, n_tags) && st.ntags != m_n_tags)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid number of tags encountered");
 
-	if (nobjects != m_n_objects)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of objects encountered");
+	if (JOURNAL_HEADER_CONTAINS(hdr, n_entry_arrays) && st.nentry_arrays != m_n_entry_arrays)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid number of entry arrays encountered");
 
-	if (nentries != m_n_entries)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of entries encountered");
+	if (! st.found_main_entry_array && 0 != m_entry_array_offset)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): did not encounter an entry array despite one specified in file header");
 
-	if (JOURNAL_HEADER_CONTAINS(hdr, n_data) && ndata != m_n_data)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of data entries encountered");
+	if (true == st.entry_seqnum_set && st.entry_seqnum != m_tail_entry_seqnum)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid tail sequence number encountered");
 
-	if (JOURNAL_HEADER_CONTAINS(hdr, n_fields) && nfields != m_n_fields)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of fields encountered");
+	if (true == st.entry_monotonic_set && st.entry_boot_id[0] == m_boot_id[0] && st.entry_boot_id[1] == m_boot_id[1] &&
+		st.entry_monotonic != m_tail_entry_monotonic)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid tail monotonic timestamp encountered");
 
-	if (JOURNAL_HEADER_CONTAINS(hdr, n_tags) && ntags != m_n_tags)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of tags encountered");
+	if (true == st.entry_realtime_set && st.entry_realtime != m_tail_entry_realtime)
+		throw journal_verification_error_t("input_journal_t::verify_finish(): invalid tail realtime timestamp encountered");
 
-	if (JOURNAL_HEADER_CONTAINS(hdr, n_entry_arrays) && nentry_arrays != m_n_entry_arrays)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid number of entry arrays encountered");
+	return;
+}
 
-	if (! found_main_entry_array && 0 != m_entry_array_offset)
-		throw journal_verification_error_t("input_journal_t::verify_file(): did not encounter an entry array despite one specified in file header");
+void
+input_journal_t::verify_file(const header_contents_t* hdr, thread_pool_t& pool) const
+{
+	TRACE_SCOPE("input_journal_t::verify_file");
 
-	if (true == entry_seqnum_set && entry_seqnum != m_tail_entry_seqnum)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid tail sequence number encountered");
+	uint64_t 				off(m_header_size);
+	object_t*				obj(nullptr);
+	verify_state_t			st = verify_state_t();
+	std::vector< uint64_t >	data;
 
-	if (true == entry_monotonic_set && entry_boot_id[0] == m_boot_id[0] && entry_boot_id[1] == m_boot_id[1] &&
-		entry_monotonic != m_tail_entry_monotonic)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid tail monotonic timestamp encountered");
+	if (nullptr == hdr)
+		throw journal_parameter_error_t("input_journal_t::verify_file(): invalid parameter encountered (nullptr)");
 
-	if (true == entry_realtime_set && entry_realtime != m_tail_entry_realtime)
-		throw journal_verification_error_t("input_journal_t::verify_file(): invalid tail realtime timestamp encountered");
+	DEBUG("Verifying all objects...");
 
+	for (;;) {
+		DEBUG("Moving to offset:              ", to_dec_string(off), " (", to_dec_string(m_tail_object_offset), ")");
+		move_to_object(object_type_t::OBJECT_UNUSED, off, &obj);
+		verify_step(st, off, obj);
+
+		/*
+		 * The payloads are hashed a batch at a time as the walk goes, so
+		 * the walk needs the same memory however many objects the file has.
+		 */
+		if (object_type_t::OBJECT_DATA == obj->object.type) {
+			data.push_back(off);
+
+			if (VERIFY_DATA_BATCH == data.size()) {
+				verify_data_hashes(data, pool);
+				data.clear();
+			}
+		}
+
+		if (true == st.found_last)
+			break;
+
+		off += ALIGN64(get_uint64(obj->object.size));
+	}
+
+	verify_finish(st, hdr);
+	verify_data_hashes(data, pool);
 	verify_entry_array();
 	verify_hash_array();
 
@@ -263,10 +293,6 @@ input_journal_t::verify_object(const uint64_t& offset, const object_t* obj) cons
 
 	switch (obj->object.type) {
 		case object_type_t::OBJECT_DATA:
-		{
-			uint64_t hash1(get_uint64(obj->data.hash)), hash2(0);
-			signed int compression(obj->object.flags & OBJECT_COMPRESSION_MASK); //, r(0);
-
 			if (0 == get_uint64(obj->data.entry_offset))
 				throw journal_verification_error_t("input_journal_t::verify_object(): unused DATA object encountered");
 
@@ -276,32 +302,16 @@ input_journal_t::verify_object(const uint64_t& offset, const object_t* obj) cons
 			if (0 >= get_uint64(obj->object.size) - offsetof(data_object_t, payload))
 				throw journal_verification_error_t("input_journal_t::verify_object(): invalid DATA object size encountered");
 
-			if (0 != compression) {
-				DEBUG("input_journal_t::verify_object(): unsupported compressed DATA object encountered");
-				//throw std::runtime_error("input_journal_t::verify_object(): unsupported compressed DATA object encountered");
-			} else
-				hash2 = hash_data(obj->data.payload, get_uint64(obj->object.size) - offsetof(object_t, data.payload));
-
-			// This is just here to suppress the warning about unused variables
-			// which itself only exists because the commented out code below is
-			// non-functional and just waiting on me to debug it to find out 
-			// where the hash calculation is incorrect.
-			hash2++;
-			hash1++;
-
-			//if (hash1 != hash2) {
-			//	INFO("verify_object(): non-matching hashes encountered: ", to_hex_string(hash1), " -> ", to_hex_string(hash2));
-			//	throw std::runtime_error("input_journal_t::verify_object(): invalid hash encountered in DATA object");
-			//}
-
+			/*
+			 * The payload hash is not checked here; see verify_data_hashes().
+			 */
 
 			if (! VALID64(obj->data.next_hash_offset) ||
 				! VALID64(obj->data.next_field_offset) ||
 				! VALID64(obj->data.entry_offset) ||
 				! VALID64(obj->data.entry_array_offset))
 				throw journal_verification_error_t("input_journal_t::verify_object(): one or more invalid offsets in DATA object encountered");
-		}
-		break;
+			break;
 
 		case object_type_t::OBJECT_FIELD:
 			if (0 >= (get_uint64(obj->object.size) - offsetof(field_object_t, payload)))
@@ -385,9 +395,122 @@ input_journal_t::verify_object(const uint64_t& offset, const object_t* obj) cons
 	return;
 }
 
+void
+input_journal_t::verify_data_hashes(const uint64_t* offsets, const std::size_t cnt) const
+{
+	TRACE_SCOPE("input_journal_t::verify_data_hashes");
+
+	std::vector< std::pair< std::size_t, uint64_t > >	order;
+	std::vector< hash_input_t >							in;
+	std::vector< uint64_t >								hashes;
+
+	/*
+	 * Payloads are grouped by length before being handed to the batch 
+	 * hasher so the lanes of each group run in lockstep for as long as 
+	 * possible.
+	 */
+	for (std::size_t idx = 0; idx < cnt; idx++) {
+		object_t* obj(nullptr);
+
+		move_to_object(OBJECT_DATA, offsets[idx], &obj);
+
+		/*
+		 * Compressed payloads would need to be decompressed before hashing,
+		 * which is not supported.
+		 */
+		if (0 != (obj->object.flags & OBJECT_COMPRESSION_MASK)) {
+			DEBUG("input_journal_t::verify_data_hashes(): unsupported compressed DATA object encountered");
+			continue;
+		}
+
+		order.push_back(std::make_pair(static_cast< std::size_t >(get_uint64(obj->object.size)), offsets[idx]));
+	}
+
+	std::sort(order.begin(), order.end());
+
+	in.resize(order.size());
+	hashes.resize(order.size());
+
+	for (std::size_t idx = 0; idx < order.size(); idx++) {
+		object_t* obj(nullptr);
+
+		move_to_object(OBJECT_DATA, order[idx].second, &obj);
+		in[idx].data = &obj->data.payload[0];
+		in[idx].size = get_uint64(obj->object.size) - offsetof(data_object_t, payload);
+	}
+
+	hash_data(in.data(), in.size(), hashes.data());
+
+	for (std::size_t idx = 0; idx < order.size(); idx++) {
+		object_t* obj(nullptr);
+
+		move_to_object(OBJECT_DATA, order[idx].second, &obj);
+
+		if (get_uint64(obj->data.hash) != hashes[idx]) {
+			ERROR("input_journal_t::verify_data_hashes(): non-matching hashes encountered at offset: ", to_hex_string(order[idx].second));
+			throw journal_verification_error_t("input_journal_t::verify_data_hashes(): invalid hash encountered in DATA object");
+		}
+	}
+
+	return;
+}
+
+void
+input_journal_t::verify_data_hashes(const std::vector< uint64_t >& offsets, thread_pool_t& pool) const
+{
+	TRACE_SCOPE("input_journal_t::verify_data_hashes");
+
+	/*
+	 * Hashing every payload is the single most expensive check, so it is 
+	 * only done at the full verification level and the payloads are hashed
+	 * as one batch across the pool after the walk has collected them; each
+	 * DATA object is hashed exactly once regardless of how many entries or
+	 * hash chains reference it.
+	 */
+	if (VERIFY_FULL != m_verify_level)
+		return;
+
+	DEBUG("Verifying ", to_dec_string(offsets.size()), " DATA object hashes...");
+
+	pool.parallel_for(offsets.size(), [this, &offsets] (const std::size_t begin, const std::size_t end) {
+		verify_data_hashes(offsets.data() + begin, end - begin);
+	});
+
+	return;
+}
+
+void
+input_journal_t::verify_entry_array_items(const uint64_t array_off, const uint64_t count, uint64_t& last) const
+{
+	object_t* obj(nullptr);
+
+	move_to_object(OBJECT_ENTRY_ARRAY, array_off, &obj);
+
+	if (count > file_entry_array_n_items(obj))
+		throw journal_verification_error_t("input_journal_t::verify_entry_array_items(): invalid entry array item count");
+
+	for (uint64_t j = 0; j < count; j++) {
+		uint64_t 	p(get_uint64(obj->entry_array.items[j]));
+		object_t*	eobj(nullptr);
+
+		if (p <= last)
+			throw journal_verification_error_t("input_journal_t::verify_entry_array_items(): unsorted entry array encountered");
+
+		last = p;
+				
+		move_to_object(OBJECT_ENTRY, p, &eobj);
+		DEBUG("Found Entry Object #: ", to_dec_string(j), " of size: ", to_dec_string(get_uint64(eobj->object.size)));
+		verify_object(p, eobj);
+	}
+
+	return;
+}
+
 void 
 input_journal_t::verify_entry_array(void) const
 {
+	TRACE_SCOPE("input_journal_t::verify_entry_array");
+
 		uint64_t idx(0), array_off(0), nentries(0), last(0);
 	
 		nentries 	= m_n_entries;
@@ -395,37 +518,56 @@ input_journal_t::verify_entry_array(void) const
 
 		DEBUG("Verifying Entry Arrays...");	
 		while (idx < nentries) {
-			uint64_t 	next(0), m(0);
+			uint64_t 	m(0);
 			object_t*	obj(nullptr);
 
 			move_to_object(OBJECT_ENTRY_ARRAY, array_off, &obj);
-			next = get_uint64(obj->entry_array.next_entry_array_offset);
-
-			m = file_entry_array_n_items(obj);
+			m = std::min(file_entry_array_n_items(obj), nentries - idx);
 
 			DEBUG("Found Entry Array at offset ", to_dec_string(array_off), " with ", to_dec_string(m), " entries of ", to_dec_string(nentries), " total entries");
-			for (uint64_t j = 0; idx < nentries && j < m; idx++, j++) {
-				uint64_t p(get_uint64(obj->entry_array.items[j]));
+			verify_entry_array_items(array_off, m, last);
 
-				if (p <= last)
-					throw journal_verification_error_t("input_journal_t::verify_entry_array(): unsorted entry array encountered");
-
-				last = p;
-				
-				move_to_object(OBJECT_ENTRY, p, &obj);
-				DEBUG("Found Entry Object #: ", to_dec_string(idx), " of size: ", to_dec_string(get_uint64(obj->object.size)));
-				verify_object(p, obj);
-				move_to_object(OBJECT_ENTRY_ARRAY, array_off, &obj);
-			}
-
-			array_off = next;
+			idx 		+= m;
+			array_off 	= get_uint64(obj->entry_array.next_entry_array_offset);
 		}
 		return;
 }
 
+void
+input_journal_t::verify_hash_bucket(const hash_item_t* htable, const uint64_t nitems, const uint64_t idx) const
+{
+	uint64_t last(0), hash_off(get_uint64(htable[idx].head_hash_offset));
+
+	while (0 != hash_off) {
+		object_t* 	obj(nullptr);
+		uint64_t 	next(0);
+
+		move_to_object(OBJECT_DATA, hash_off, &obj);
+
+		DEBUG("Found Data Object #: ", to_dec_string(idx), " at offset: ", to_hex_string(hash_off), " of size: ", to_dec_string(get_uint64(obj->object.size)));
+		next = get_uint64(obj->data.next_hash_offset);
+
+		if (0 != next && next <= hash_off)
+			throw journal_verification_error_t("input_journal_t::verify_hash_bucket(): hash chain cycle encountered");
+
+		if ((get_uint64(obj->data.hash) % nitems) != idx)
+			throw journal_verification_error_t("input_journal_t::verify_hash_bucket(): hash value mismatch encountered");
+
+		last 		= hash_off;
+		hash_off 	= next;
+	}
+
+	if (last != get_uint64(htable[idx].tail_hash_offset)) 
+		throw journal_verification_error_t("input_journal_t::verify_hash_bucket(): tail hash pointer mismatch in hash table encountered");
+
+	return;
+}
+
 void 
 input_journal_t::verify_hash_array(void) const
 {
+	TRACE_SCOPE("input_journal_t::verify_hash_array");
+
 	const uint64_t 	nitems(m_data_hash_table_size / sizeof(hash_item_t));
 	hash_item_t*	htable(nullptr);
 
@@ -435,93 +577,138 @@ input_journal_t::verify_hash_array(void) const
 
 	DEBUG("Found Data Hash Table Object at offset: ", to_dec_string(m_data_hash_table_offset), " with ", to_dec_string(nitems), " items");
 
-	for (uint64_t idx = 0; idx < nitems; idx++) {
-		uint64_t last(0), hash_off(get_uint64(htable[idx].head_hash_offset));
+	for (uint64_t idx = 0; idx < nitems; idx++) 
+		verify_hash_bucket(htable, nitems, idx);
+
+	return;
+}
+
+const uint64_t
+input_journal_t::verify(const char* name)
+{
+	TRACE_SCOPE("input_journal_t::verify");
+
+	thread_pool_t					pool(m_threads);
+	std::vector< uint64_t >			offsets;
+	std::vector< uint64_t >			data;
+	std::vector< entry_segment_t >	segments;
+	verify_state_t					st = verify_state_t();
+	uint64_t						off(0), idx(0), last(0), nitems(0);
+	hash_item_t*					htable(nullptr);
+
+	open(name);
+
+	if (0 == m_tail_object_offset)
+		return 0;
+
+	/*
+	 * The object chain can only be discovered sequentially, but doing so 
+	 * requires nothing more than each object header. The per-object checks
+	 * of verify_object() are then chunked across the pool. Only the generic
+	 * check_object() of move_to_object() is cached in m_validated, which
+	 * spares the later passes repeating it; the ordering pass, which must
+	 * run in file order, and the hash, chain and entry array passes still
+	 * do all of their own work.
+	 */
+	off = m_header_size;
+
+	for (;;) {
+		void* tmp(nullptr);
+
+		move_to(object_type_t::OBJECT_UNUSED, off, sizeof(object_header_t), &tmp);
+		offsets.push_back(off);
+
+		if (off == m_tail_object_offset)
+			break;
 
-		while (0 != hash_off) {
-			object_t* 	obj(nullptr);
-			uint64_t 	next(0);
+		if (0 == get_uint64(static_cast< object_header_t* >(tmp)->size))
+			throw journal_verification_error_t("input_journal_t::verify(): zero sized object encountered");
 
-			move_to_object(OBJECT_DATA, hash_off, &obj);
+		off += ALIGN64(get_uint64(static_cast< object_header_t* >(tmp)->size));
 
-			DEBUG("Found Data Object #: ", to_dec_string(idx), " at offset: ", to_hex_string(hash_off), " of size: ", to_dec_string(get_uint64(obj->object.size)));
-			next = get_uint64(obj->data.next_hash_offset);
+		if (off > m_tail_object_offset)
+			throw journal_verification_error_t("input_journal_t::verify(): invalid tail object offset encountered");
+	}
 
-			if (0 != next && next <= hash_off)
-				throw journal_verification_error_t("input_journal_t::verify_hash_array(): hash chain cycle encountered");
+	pool.parallel_for(offsets.size(), [this, &offsets] (const std::size_t begin, const std::size_t end) {
+		TRACE_SCOPE("input_journal_t::verify_object");
 
-			if ((get_uint64(obj->data.hash) % nitems) != idx)
-				throw journal_verification_error_t("input_journal_t::verify_hash_array(): hash value mismatch encountered");
+		for (std::size_t idx = begin; idx < end; idx++) {
+			object_t* obj(nullptr);
 
-			last 		= hash_off;
-			hash_off 	= next;
+			move_to_object(object_type_t::OBJECT_UNUSED, offsets[idx], &obj);
+			verify_object(offsets[idx], obj);
 		}
+	});
+
+	for (std::size_t idx = 0; idx < offsets.size(); idx++) {
+		object_t* obj(nullptr);
 
-		if (last != get_uint64(htable[idx].tail_hash_offset)) 
-			throw journal_verification_error_t("input_journal_t::verify_hash_array(): tail hash pointer mismatch in hash table encountered");
+		move_to_object(object_type_t::OBJECT_UNUSED, offsets[idx], &obj);
+		verify_step(st, offsets[idx], obj);
 	}
 
-	return;
-}
+	verify_finish(st, reinterpret_cast< const header_contents_t* >(m_ptr));
 
-obj_hdr_t*
-input_journal_t::to_cpp_object(const object_t* obj) const
-{
-	if (nullptr == obj)
-		throw journal_parameter_error_t("input_journal_t::to_cpp_object(): invalid parameter encountered (nullptr)");
+	for (std::size_t idx = 0; idx < offsets.size(); idx++) {
+		object_t* obj(nullptr);
 
-	switch (obj->object.type) {
-        case object_type_t::OBJECT_DATA:
-        {
-            data_obj_t* dobj(new data_obj_t(obj->object.flags, obj->object.size, get_uint64(obj->data.hash), get_uint64(obj->data.n_entries)));
-
-            dobj->payload().resize(get_uint64(obj->object.size) - offsetof(data_object_t, payload));
-            std::memcpy(dobj->payload().data(), &obj->data.payload[0], get_uint64(obj->object.size) - offsetof(data_object_t, payload));
-			return dobj;
-        }
-		break;
+		move_to_object(object_type_t::OBJECT_UNUSED, offsets[idx], &obj);
 
-		case object_type_t::OBJECT_FIELD:
-        {
-            field_obj_t* fobj(new field_obj_t(obj->object.flags, obj->object.size, get_uint64(obj->data.hash)));
+		if (object_type_t::OBJECT_DATA == obj->object.type)
+			data.push_back(offsets[idx]);
+	}
 
-            fobj->payload().resize(get_uint64(obj->object.size) - offsetof(field_object_t, payload));
-            std::memcpy(fobj->payload().data(), &obj->field.payload[0], get_uint64(obj->object.size) - offsetof(field_object_t, payload));
-			return fobj;
-        }
-		break;
+	verify_data_hashes(data, pool);
 
-        case object_type_t::OBJECT_ENTRY:
-        {
-            entry_obj_t* eobj(new entry_obj_t(obj->object.flags, obj->object.size, get_uint64(obj->entry.seqnum), 
-												get_uint64(obj->entry.realtime), get_uint64(obj->entry.monotonic),
-                            {get_uint64(obj->entry.boot_id[0]), get_uint64(obj->entry.boot_id[1])}, get_uint64(obj->entry.xor_hash)));
+	/*
+	 * Entry arrays are split into segments; each segment carries the last
+	 * entry offset of its predecessor so sort order is still checked across
+	 * array boundaries.
+	 */
+	off = m_entry_array_offset;
 
-            for (std::size_t idx = 0; idx < file_entry_n_items(obj); idx++) {
-                object_t* tmp(nullptr);
-                move_to_object(object_type_t::OBJECT_UNUSED, get_uint64(obj->entry.items[idx].object_offset), &tmp);
-            	eobj->items().push_back(to_cpp_object(tmp));
-			}
+	while (idx < m_n_entries) {
+		object_t*		obj(nullptr);
+		entry_segment_t	seg;
 
-			return eobj;
-        }
-		break;
+		move_to_object(OBJECT_ENTRY_ARRAY, off, &obj);
 
-        case object_type_t::OBJECT_TAG:
-        {
-            tag_obj_t* tobj(new tag_obj_t(obj->object.flags, obj->object.size, get_uint64(obj->tag.seqnum), get_uint64(obj->tag.epoch)));
+		seg.offset	= off;
+		seg.count	= std::min(file_entry_array_n_items(obj), m_n_entries - idx);
+		seg.last	= last;
 
-            std::memcpy(&tobj->tag()[0], &obj->tag.tag[0], tobj->tag().size());
-        	return tobj;
-		}
-        break;
+		if (0 == seg.count)
+			throw journal_verification_error_t("input_journal_t::verify(): empty entry array encountered");
 
-		default:
-			break;
+		segments.push_back(seg);
+
+		last 	= get_uint64(obj->entry_array.items[seg.count - 1]);
+		idx 	+= seg.count;
+		off 	= get_uint64(obj->entry_array.next_entry_array_offset);
 	}
 
-	throw journal_parameter_error_t("input_journal_t::to_cpp_object(): invalid/unknown object type provided");
-	return nullptr;
+	pool.parallel_for(segments.size(), [this, &segments] (const std::size_t begin, const std::size_t end) {
+		TRACE_SCOPE("input_journal_t::verify_entry_array_items");
+
+		for (std::size_t idx = begin; idx < end; idx++) {
+			uint64_t last(segments[idx].last);
+
+			verify_entry_array_items(segments[idx].offset, segments[idx].count, last);
+		}
+	});
+
+	nitems = m_data_hash_table_size / sizeof(hash_item_t);
+	move_to(OBJECT_DATA_HASH_TABLE, m_data_hash_table_offset, m_data_hash_table_size, reinterpret_cast< void** >(&htable));
+
+	pool.parallel_for(nitems, [this, htable, nitems] (const std::size_t begin, const std::size_t end) {
+		TRACE_SCOPE("input_journal_t::verify_hash_bucket");
+
+		for (std::size_t idx = begin; idx < end; idx++) 
+			verify_hash_bucket(htable, nitems, idx);
+	});
+
+	return offsets.size();
 }
 
 void
@@ -532,42 +719,80 @@ input_journal_t::reset(void)
 	return;
 }
 
+/*
+ * Every object reached through move_to_object() is checked once; from the
+ * structural level on that includes the per-object checks of
+ * verify_object(), so they hold for the objects an entry cursor or the
+ * writer visits as much as for those of a verification walk.
+ */
+void
+input_journal_t::check_object(const uint64_t& offset, const object_t* obj) const
+{
+	journal_base_t::check_object(offset, obj);
+
+	if (VERIFY_STRUCTURAL <= m_verify_level)
+		verify_object(offset, obj);
+
+	return;
+}
+
+void
+input_journal_t::dealloc(void)
+{
+	if (false == m_mapped) {
+		journal_base_t::dealloc();
+		return;
+	}
+
+	input_file_t::unmap(m_ptr, m_size);
+	m_ptr		= nullptr;
+	m_size		= 0;
+	m_mapped	= false;
+
+	m_validated.clear();
+	return;
+}
+
 void
-input_journal_t::parse(const char* name)
+input_journal_t::open(const char* name)
 {
+	TRACE_SCOPE("input_journal_t::open");
+
 	input_file_t 		inf;
 	header_contents_t*	hdr(nullptr);
 	std::size_t			siz(0);
-	//uint8_t*			ptr(nullptr);
-	uint64_t			off(0);
-	object_t*			obj(nullptr);
 
 	if (nullptr == name)
-		throw journal_parameter_error_t("input_journal_t::parse(): invalid filename (null)");
+		throw journal_parameter_error_t("input_journal_t::open(): invalid filename (null)");
 		
 	inf.open(name);
 		
 	siz = static_cast< std::size_t >(inf.size());
 
 	if (0 > static_cast< off_t >(siz)) 
-		throw journal_parse_error_t("input_journal_t::parse(): invalid file size");
+		throw journal_parse_error_t("input_journal_t::open(): invalid file size");
+	if (sizeof(header_contents_t) > siz)
+		throw journal_parse_error_t("input_journal_t::open(): file too small to contain a header");
 
 	reset();
 
-	if (false == alloc(siz))
-		throw std::runtime_error("input_journal_t::parse(): error allocating memory");
+	/*
+	 * The file is mapped read-only rather than read into the heap so that
+	 * callers walking the entry array chain only ever fault in the pages
+	 * they touch; resident memory then tracks the working set rather than
+	 * the size of the journal.
+	 */
+	m_ptr 		= inf.map(siz);
+	m_size 		= siz;
+	m_mapped	= true;
 
-	try {
-		inf.read(m_ptr, siz);
-	} catch (std::exception& e) {
-		throw e;
-	}
+	m_validated.resize(m_size / 8);
 
 	inf.close();
 	hdr = reinterpret_cast< header_contents_t* >(m_ptr);
 			
 	if (0 != std::memcmp(&hdr->signature[0], HEADER_SIGNATURE, 8))
-		throw journal_parse_error_t("input_journal_t::parse(): invalid file magic"); 
+		throw journal_parse_error_t("input_journal_t::open(): invalid file magic"); 
 
 	DEBUG("File Header: ");
 	DEBUG("===============================================================");
@@ -582,6 +807,7 @@ input_journal_t::parse(const char* name)
 
 	m_file_id[0]				= get_uint64(hdr->file_id[0]);
 	m_file_id[1]				= get_uint64(hdr->file_id[1]);
+	update_hash_key();
 	DEBUG("File ID:                       ", std::string(to_hex_string(m_file_id[0]) + to_hex_string(m_file_id[1])));
 
 	m_machine_id[0]				= get_uint64(hdr->machine_id[0]);
@@ -661,87 +887,59 @@ input_journal_t::parse(const char* name)
 	DEBUG("===============================================================");
 
 	m_parsed = true;
-	verify_offsets();
 
-	if (0 == m_tail_object_offset)
-		return;
+	if (VERIFY_NONE != m_verify_level)
+		verify_offsets();
 
-	verify_file(hdr);
-
-	DEBUG("Parsing Objects...");
+	return;
+}
 
-	off = m_header_size;
+void
+input_journal_t::scan_offsets(object_index_t& tbl) const
+{
+	TRACE_SCOPE("input_journal_t::scan_offsets");
 
+	const bool		structural(VERIFY_STRUCTURAL == m_verify_level);
+	uint64_t 		off(m_header_size);
+	void*			tmp(nullptr);
+	verify_state_t	st = verify_state_t();
+
+	/*
+	 * After a full verify_file() every object along this walk has already
+	 * been checked, so the pre-scan only reads each object header for its
+	 * type and size. At the structural level this walk is the only one, 
+	 * so the per-object and header consistency checks are folded into it
+	 * instead.
+	 */
 	for (;;) {
-		DEBUG("Parsing Object at offset: ", to_dec_string(off));
+		const object_header_t* hdr(nullptr);
 
-		move_to_object(object_type_t::OBJECT_UNUSED, off, &obj);
-
-		switch (obj->object.type) {
-			case object_type_t::OBJECT_DATA:
-			{
-				data_obj_t dobj(obj->object.flags, obj->object.size, get_uint64(obj->data.hash), get_uint64(obj->data.n_entries));
+		if (true == structural) {
+			object_t* obj(nullptr);
 
-				dobj.payload().resize(get_uint64(obj->object.size) - offsetof(data_object_t, payload));
-				std::memcpy(dobj.payload().data(), &obj->data.payload[0], get_uint64(obj->object.size) - offsetof(data_object_t, payload));
+			move_to_object(object_type_t::OBJECT_UNUSED, off, &obj);
+			verify_step(st, off, obj);
+			hdr = &obj->object;
+		} else {
+			move_to(object_type_t::OBJECT_UNUSED, off, sizeof(object_header_t), &tmp);
+			hdr = static_cast< const object_header_t* >(tmp);
+		}
 
-				DEBUG("Parsed Data Object: ");
-				DEBUG("  Hash:                        ", to_hex_string(dobj.hash()));
-				DEBUG("  Number of Entries:           ", to_dec_string(dobj.n_entries()));
-				DEBUG("  Payload:                     ", std::string((char*)dobj.payload().data(), dobj.payload().size()));
-				m_data_objects.push_back(dobj);	
-			}
+		switch (hdr->type) {
+			case object_type_t::OBJECT_DATA:
+				tbl.add(INDEX_DATA, off);
 			break;
 
 			case object_type_t::OBJECT_FIELD:
-			{
-				field_obj_t fobj(obj->object.flags, obj->object.size, get_uint64(obj->data.hash));
-				
-				fobj.payload().resize(get_uint64(obj->object.size) - offsetof(field_object_t, payload));
-				std::memcpy(fobj.payload().data(), &obj->field.payload[0], get_uint64(obj->object.size) - offsetof(field_object_t, payload));
-		
-				DEBUG("Parsed Field Object: ");
-				DEBUG("  Hash:                        ", to_hex_string(fobj.hash())); 
-				DEBUG("  Payload:                     ", std::string((char*)fobj.payload().data(), fobj.payload().size()));
-				m_field_objects.push_back(fobj);
-			}
+				tbl.add(INDEX_FIELD, off);
 			break;
-			
-			case object_type_t::OBJECT_ENTRY:
-			{
-				entry_obj_t eobj(obj->object.flags, obj->object.size, get_uint64(obj->entry.seqnum), 
-								get_uint64(obj->entry.realtime), get_uint64(obj->entry.monotonic), 
-								{get_uint64(obj->entry.boot_id[0]), get_uint64(obj->entry.boot_id[1])}, get_uint64(obj->entry.xor_hash));
-
-				DEBUG("Parsed Entry Object: ");
-				DEBUG("  Sequence Number:             ", to_hex_string(eobj.seqnum()));
-				DEBUG("  Realtime Timestamp:          ", to_dec_string(eobj.realtime()));
-				DEBUG("  Monotonic Timestamp:         ", to_dec_string(eobj.monotonic()));
-				DEBUG("  Boot ID:                     ", to_hex_string(eobj.boot_id()[0]), to_hex_string(eobj.boot_id()[1]));
-				DEBUG("  XOR Hash:                    ", to_hex_string(eobj.xor_hash()));
-
-				for (std::size_t idx = 0; idx < file_entry_n_items(obj); idx++) {
-					object_t* tmp(nullptr);
-
-					move_to_object(object_type_t::OBJECT_UNUSED, get_uint64(obj->entry.items[idx].object_offset), &tmp);
-					eobj.items().push_back(to_cpp_object(tmp));
-				}
 
-				m_entry_objects.push_back(eobj);
-			}
+			case object_type_t::OBJECT_ENTRY:
+				tbl.add(INDEX_ENTRY, off);
 			break;
 
 			case object_type_t::OBJECT_TAG:
-			{
-				tag_obj_t tobj(obj->object.flags, obj->object.size, get_uint64(obj->tag.seqnum), get_uint64(obj->tag.epoch));
-
-				std::memcpy(&tobj.tag()[0], &obj->tag.tag[0], tobj.tag().size());
-				DEBUG("Parsed Tag Object: ");
-				DEBUG("  Sequence Number:             ", to_hex_string(tobj.seqnum()));
-				DEBUG("  Epoch Timestamp:             ", to_dec_string(tobj.epoch()));
-				DEBUG("  Tag:                         ", std::string((char*)&tobj.tag()[0], tobj.tag().size()));
-				m_tag_objects.push_back(tobj);
-			}
+				tbl.add(INDEX_TAG, off);
 			break;
 
 			default:
@@ -751,89 +949,253 @@ input_journal_t::parse(const char* name)
 		if (off == m_tail_object_offset)
 			break;
 
-		off += ALIGN64(get_uint64(obj->object.size));
+		if (0 == get_uint64(hdr->size))
+			throw journal_verification_error_t("input_journal_t::scan_offsets(): zero sized object encountered");
+
+		off += ALIGN64(get_uint64(hdr->size));
 	}
 
-	DEBUG("Parsed ", to_dec_string(m_data_objects.size()), " Data Objects");
-	DEBUG("Parsed ", to_dec_string(m_field_objects.size()), " Field Objects");
-	DEBUG("Parsed ", to_dec_string(m_entry_objects.size()), " Entry Objects");
-	DEBUG("Parsed ", to_dec_string(m_tag_objects.size()), " Tag Objects");
-	
-	return;			
+	if (true == structural)
+		verify_finish(st, reinterpret_cast< const header_contents_t* >(m_ptr));
+
+	tbl.finish();
+	return;
 }
 
-const bool 
-input_journal_t::has_field(const std::string& field_name) const
+void
+input_journal_t::index_objects(object_index_t& tbl) const
 {
-	const std::size_t 	mfval(m_field_objects.size());
+	TRACE_SCOPE("input_journal_t::index_objects");
 
-	if (0 != field_name.length()) {
-		for (std::size_t idx = 0; idx < mfval; idx++) {
-			if (! ::strcasecmp(field_name.c_str(), m_field_objects[idx].to_string().c_str())) 
-				return true;
-		}	
+	if (true == m_index_file.empty()) {
+		scan_offsets(tbl);
+		return;
 	}
 
-	return false;
+	/*
+	 * A valid sidecar means the file was walked when it was written, so 
+	 * the structural checks that would have been folded into the walk 
+	 * are not repeated; it is only valid if that walk made them, i.e. it
+	 * was built at VERIFY_STRUCTURAL or above. A weaker one is rebuilt.
+	 * VERIFY_FULL walks the file in verify_file() regardless, so it asks
+	 * no more of the sidecar than VERIFY_STRUCTURAL does.
+	 */
+	if (true == tbl.load(m_index_file, m_file_id, m_tail_object_offset, std::min(m_verify_level, VERIFY_STRUCTURAL))) {
+		DEBUG("input_journal_t::index_objects(): using object index: ", m_index_file);
+		return;
+	}
+
+	scan_offsets(tbl);
+
+	if (false == tbl.save(m_index_file, m_file_id, m_tail_object_offset, m_verify_level))
+		ERROR("Unable to write object index: ", m_index_file);
+
+	return;
 }
 
-const bool
-input_journal_t::has_field_value(const std::string& field_value) const
+const std::size_t
+input_journal_t::threads(void) const
 {
-	const std::size_t 	mdval(m_data_objects.size());
+	return m_threads;
+}
 
-	if (0 != field_value.length()) {
-		for (std::size_t idx = 0; idx < mdval; idx++) {
-			std::string field_data(m_data_objects[idx].to_string());
+void
+input_journal_t::threads(const std::size_t cnt)
+{
+	m_threads = cnt;
+	return;
+}
 
-			do {
-				if (field_data.length() < field_value.length())
-					break;
+const verify_level_t
+input_journal_t::verify_level(void) const
+{
+	return m_verify_level;
+}
 
-				if (! ::strncasecmp(field_value.c_str(), field_data.c_str(), field_value.length()))
-					return true;
-			
-				field_data = field_data.substr(1);
-			} while (field_data.length() >= field_value.length() && 0 != field_data.length());
-		}
+void
+input_journal_t::verify_level(const verify_level_t level)
+{
+	if (VERIFY_LEVEL_MAX <= level)
+		throw journal_parameter_error_t("input_journal_t::verify_level(): invalid verification level");
+
+	m_verify_level = level;
+	return;
+}
+
+const std::string&
+input_journal_t::index_file(void) const
+{
+	return m_index_file;
+}
+
+void
+input_journal_t::index_file(const std::string& name)
+{
+	m_index_file = name;
+	return;
+}
+
+/*
+ * The verification walk of VERIFY_FULL for an already opened journal, for
+ * callers that walk its entries themselves rather than parsing it. At the
+ * lower levels such callers rely on check_object(), which checks whatever
+ * object they visit; only the header consistency checks of the parsing
+ * walk are then not made.
+ */
+void
+input_journal_t::verify_input(void) const
+{
+	if (false == m_parsed || nullptr == m_ptr)
+		throw journal_invalid_logic_error_t("input_journal_t::verify_input(): called prior to opening journal");
+
+	if (0 != m_tail_object_offset && VERIFY_FULL == m_verify_level) {
+		thread_pool_t pool(m_threads);
+
+		verify_file(reinterpret_cast< header_contents_t* >(m_ptr), pool);
 	}
-			
-	return false;
+
+	return;
 }
 
-const uint64_t
-input_journal_t::get_field_hash(const std::string& field_name) const
+void
+input_journal_t::parse(const char* name, const entry_filter_t& filter, entry_sink_t& sink)
+{
+	TRACE_SCOPE("input_journal_t::parse");
+
+	open(name);
+	parse(filter, sink);
+	return;
+}
+
+void
+input_journal_t::parse(const entry_filter_t& filter, entry_sink_t& sink)
 {
-	const std::size_t	mfval(m_field_objects.size());
+	TRACE_SCOPE("input_journal_t::parse");
 
-	for (std::size_t idx = 0; idx < mfval; idx++) {
-		if (! ::strcasecmp(field_name.c_str(), m_field_objects[idx].to_string().c_str()))
-			return m_field_objects[idx].hash();
+	object_index_t	tbl;
+	object_t*		obj(nullptr);
+	uint64_t		nmatches(0);
+
+	if (false == m_parsed || nullptr == m_ptr)
+		throw journal_invalid_logic_error_t("input_journal_t::parse(): called prior to opening journal");
+
+	if (0 == m_tail_object_offset)
+		return;
+
+	verify_input();
+
+	/*
+	 * Only ENTRY objects are of interest here: each is classified in
+	 * place and handed to the sink, which resolves whatever items it needs
+	 * from the mapping. Nothing is copied into the object vectors.
+	 */
+	DEBUG("Parsing Objects with filter...");
+	index_objects(tbl);
+
+	for (uint64_t idx = 0; idx < tbl.count(INDEX_ENTRY); idx++) {
+		const uint64_t	off(tbl.offsets(INDEX_ENTRY)[idx]);
+		bool			match(false);
+
+		move_to_object(object_type_t::OBJECT_ENTRY, off, &obj);
+		match = filter.match(obj);
+
+		DEBUG("Classified entry at offset: ", to_hex_string(off), " match: ", (true == match ? "yes" : "no"));
+		sink.entry(*this, obj, match);
+
+		if (true == match)
+			nmatches++;
 	}
 
-	throw journal_invalid_logic_error_t("input_journal_t::get_field_hash(): called on nonexistent field");
-	return uint64_t(0);
+	DEBUG("Classified ", to_dec_string(tbl.count(INDEX_ENTRY)), " Entry Objects (", to_dec_string(nmatches), " matches)");
+	return;
 }
 
-const uint64_t 
-input_journal_t::get_field_value_hash(const std::string& field_value) const
+const bool
+input_journal_t::get_field_data_hashes(const std::string& field_name, std::vector< uint64_t >& hashes) const
 {
-	const std::size_t   	mdval(m_data_objects.size());
+	const uint64_t 	nitems(m_field_hash_table_size / sizeof(hash_item_t));
+	hash_item_t*	htable(nullptr);
+	object_t*		obj(nullptr);
+	uint64_t		p(0), d(0);
+	bool			found(false);
+
+	if (0 == field_name.length() || 0 == nitems)
+		return false;
+
+	/*
+	 * Rather than scanning every DATA object for a matching "FIELD=" prefix
+	 * we locate the FIELD object via the field hash table and then follow
+	 * its head_data_offset/next_field_offset chain, which links every DATA
+	 * object carrying a value for that field. Field names are matched
+	 * regardless of case, as they always were, so every bucket is looked
+	 * at rather than just the one of the name's hash; the table holds no
+	 * more than the few FIELD objects of the journal.
+	 */
+	move_to(OBJECT_FIELD_HASH_TABLE, m_field_hash_table_offset, m_field_hash_table_size, reinterpret_cast< void** >(&htable));
+
+	for (uint64_t idx = 0; idx < nitems; idx++) {
+		p = get_uint64(htable[idx].head_hash_offset);
 
-	for (std::size_t idx = 0; idx < mdval; idx++) {
-		std::string field_data(m_data_objects[idx].to_string());
+		while (0 != p) {
+			move_to_object(OBJECT_FIELD, p, &obj);
 
-		do {
-			if (! ::strncasecmp(field_value.c_str(), field_data.c_str(), field_value.length()))
-				return m_data_objects[idx].hash();
+			if (get_uint64(obj->object.size) - offsetof(field_object_t, payload) == field_name.length() &&
+				! ::strncasecmp(field_name.c_str(), reinterpret_cast< const char* >(&obj->field.payload[0]), field_name.length())) {
+				found 	= true;
+				d 		= get_uint64(obj->field.head_data_offset);
 
-			field_data = field_data.substr(1);
+				while (0 != d) {
+					object_t* data(nullptr);
 
-		} while (field_data.length() >= field_data.length() && 0 != field_data.length());
+					move_to_object(OBJECT_DATA, d, &data);
+					hashes.push_back(get_uint64(data->data.hash));
 
+					DEBUG("input_journal_t::get_field_data_hashes(): Found ", field_name, " value at offset: ", to_hex_string(d));
+					d = get_uint64(data->data.next_field_offset);
+				}
+			}
+
+			p = get_uint64(obj->field.next_hash_offset);
+		}
 	}
 
-	throw journal_invalid_logic_error_t("input_journal_t::get_field_value_hash(): no such field value identified");
-	return uint64_t(0);
+	if (false == found)
+		return false;
+
+	std::sort(hashes.begin(), hashes.end());
+	hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+	return true;
 }
 
+const bool
+input_journal_t::find_field_value_hash(const std::string& field_value, uint64_t& hash) const
+{
+	uint64_t	off(m_header_size);
+	object_t*	obj(nullptr);
+
+	if (0 == field_value.length() || 0 == m_tail_object_offset)
+		return false;
+
+	for (;;) {
+		move_to_object(OBJECT_UNUSED, off, &obj);
+
+		if (OBJECT_DATA == obj->object.type) {
+			const char*			payload(reinterpret_cast< const char* >(&obj->data.payload[0]));
+			const std::size_t	len(get_uint64(obj->object.size) - offsetof(data_object_t, payload));
+
+			for (std::size_t idx = 0; idx + field_value.length() <= len; idx++) {
+				if (! ::strncasecmp(field_value.c_str(), payload + idx, field_value.length())) {
+					hash = get_uint64(obj->data.hash);
+					return true;
+				}
+			}
+		}
+
+		if (off == m_tail_object_offset)
+			break;
+
+		off += ALIGN64(get_uint64(obj->object.size));
+	}
+
+	return false;
+}
@@ -18,20 +18,86 @@
 #include "log.hpp"
 #include "siphash.hpp"
 #include "lookup3.hpp"
+#include "filter.hpp"
+#include "thread_pool.hpp"
+#include "object_index.hpp"
+
+/* DATA objects whose payload hashes verify_file() checks at a time */
+#define VERIFY_DATA_BATCH (64 * 1024)
+
+/*
+ * VERIFY_NONE			no checks beyond those needed to dereference objects
+ * VERIFY_HEADER		header offsets and sizes only
+ * VERIFY_STRUCTURAL	per-object and header consistency checks, done in the
+ *						same walk that discovers the objects
+ * VERIFY_FULL			a separate verification walk plus entry array and 
+ *						hash chain traversal before parsing
+ */
+typedef enum
+{
+	VERIFY_NONE = 0,
+	VERIFY_HEADER,
+	VERIFY_STRUCTURAL,
+	VERIFY_FULL,
+	VERIFY_LEVEL_MAX
+} verify_level_t;
+
+typedef struct {
+	uint64_t		nobjects;
+	uint64_t		nfields;
+	uint64_t		ntags;
+	uint64_t		nentries;
+	uint64_t		ndata_hash_tables;
+	uint64_t		nfield_hash_tables;
+	uint64_t		nentry_arrays;
+	uint64_t		ndata;
+	uint64_t		last_tag_realtime;
+	uint64_t		entry_seqnum;
+	uint64_t		entry_monotonic;
+	uint64_t		entry_realtime;
+	uint64_t		last_tag;
+	uint64_t		last_epoch;
+	bool			entry_seqnum_set;
+	bool			entry_monotonic_set;
+	bool			entry_realtime_set;
+	bool			found_main_entry_array;
+	bool			found_last;
+	uint128_vec_t	entry_boot_id;
+} verify_state_t;
+
+typedef struct {
+	uint64_t		offset;
+	uint64_t		count;
+	uint64_t		last;
+} entry_segment_t;
 
 class input_journal_t : public journal_base_t
 {
 	private:
 	protected:
 		bool			m_parsed;
+		bool			m_mapped;
+		std::size_t		m_threads;
+		std::string		m_index_file;
+		verify_level_t	m_verify_level;
+
+		virtual void dealloc(void);
+		virtual void check_object(const uint64_t&, const object_t*) const;
 
-		virtual void verify_file(const header_contents_t*) const;	
+		virtual void verify_file(const header_contents_t*, thread_pool_t&) const;	
+		virtual void verify_step(verify_state_t&, const uint64_t, const object_t*) const;
+		virtual void verify_finish(verify_state_t&, const header_contents_t*) const;
 		virtual void verify_offsets(void) const;
 		virtual void verify_object(const uint64_t& offset, const object_t* obj) const;
+		virtual void verify_data_hashes(const uint64_t*, const std::size_t) const;
+		virtual void verify_data_hashes(const std::vector< uint64_t >&, thread_pool_t&) const;
 		virtual void verify_entry_array(void) const;	
+		virtual void verify_entry_array_items(const uint64_t, const uint64_t, uint64_t&) const;
 		virtual void verify_hash_array(void) const;
+		virtual void verify_hash_bucket(const hash_item_t*, const uint64_t, const uint64_t) const;
 
-		virtual obj_hdr_t* to_cpp_object(const object_t*) const;
+		virtual void scan_offsets(object_index_t&) const;
+		virtual void index_objects(object_index_t&) const;
 
 	public:
 
@@ -41,13 +107,24 @@ class input_journal_t : public journal_base_t
 		virtual ~input_journal_t(void);
 
 		virtual void reset(void);
-		virtual void parse(const char* name);
 
-		virtual const bool has_field(const std::string&) const;
-		virtual const bool has_field_value(const std::string&) const;
-		
-		virtual const uint64_t get_field_hash(const std::string&) const;
-		virtual const uint64_t get_field_value_hash(const std::string&) const;
+		virtual const std::size_t threads(void) const;
+		virtual void threads(const std::size_t);
+
+		virtual const verify_level_t verify_level(void) const;
+		virtual void verify_level(const verify_level_t);
+
+		virtual const std::string& index_file(void) const;
+		virtual void index_file(const std::string&);
+		virtual void open(const char* name);
+		virtual const uint64_t verify(const char* name);
+		virtual void verify_input(void) const;
+		virtual void parse(const char* name, const entry_filter_t&, entry_sink_t&);
+		virtual void parse(const entry_filter_t&, entry_sink_t&);
+
+		virtual const bool get_field_data_hashes(const std::string&, std::vector< uint64_t >&) const;
+
+		virtual const bool find_field_value_hash(const std::string&, uint64_t&) const;
 		
 };
 
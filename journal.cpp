@@ -35,20 +35,24 @@ journal_base_t::alloc(const std::size_t siz)
 		dealloc();
 	}*/
 
-	ptr = new uint8_t[siz];
-	std::memset(ptr, 0, siz);
+	/*
+	 * An anonymous mapping reads as zero and only takes memory once its
+	 * pages are written, and mremap(2) resizes it by moving the pages
+	 * rather than copying them, so a growing arena neither needs clearing
+	 * nor holds two copies of itself.
+	 */
+	if (nullptr == m_ptr)
+		ptr = static_cast< uint8_t* >(::mmap(nullptr, siz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+	else
+		ptr = static_cast< uint8_t* >(::mremap(m_ptr, m_size, siz, MREMAP_MAYMOVE));
 
-	if (nullptr != m_ptr) {
-		if (m_size <= siz)
-			std::memcpy(ptr, m_ptr, m_size);
-		else
-			std::memcpy(ptr, m_ptr, siz);
-	
-		dealloc();
-	}
+	if (MAP_FAILED == ptr)
+		return false;
 
 	m_ptr 	= ptr;
 	m_size	= siz;
+
+	m_validated.resize(m_size / 8);
 	return true;
 }
 
@@ -69,9 +73,11 @@ journal_base_t::dealloc(void)
 	if (nullptr == m_ptr)
 		return;
 
-	delete[] m_ptr;
+	(void)::munmap(m_ptr, m_size);
 	m_ptr 	= nullptr;
 	m_size	= 0;
+
+	m_validated.clear();
 	return;
 }
 
@@ -81,17 +87,40 @@ journal_base_t::hash_data(const void* data, const std::size_t size) const
 	if (nullptr == data || 0 == size)
 		throw journal_parameter_error_t("journal_base_t::hash_data(): invalid parameter (nullptr/0 length)");
 
-	if (JOURNAL_HEADER_KEYED_HASH(m_incompatible_flags)) {
-		siphash_t 	sh;
-		sbarray_t	file_id;
-
-		std::memcpy(&file_id[0], &m_file_id[0], file_id.size());
-		return sh.hash(data, size, file_id);
-	}
+	if (JOURNAL_HEADER_KEYED_HASH(m_incompatible_flags)) 
+		return siphash24(data, size, m_hash_key);
 
 	return jenkins_hash64_t::hash(data, size);
 }
 
+void
+journal_base_t::hash_data(const hash_input_t* in, const std::size_t cnt, uint64_t* out) const
+{
+	if (nullptr == in || nullptr == out)
+		throw journal_parameter_error_t("journal_base_t::hash_data(): invalid parameter (nullptr)");
+
+	for (std::size_t idx = 0; idx < cnt; idx++) 
+		if (nullptr == in[idx].data || 0 == in[idx].size)
+			throw journal_parameter_error_t("journal_base_t::hash_data(): invalid parameter (nullptr/0 length)");
+
+	if (JOURNAL_HEADER_KEYED_HASH(m_incompatible_flags)) 
+		batch_hash_t::siphash24(in, cnt, m_hash_key, out);
+	else
+		batch_hash_t::jenkins(in, cnt, out);
+
+	return;
+}
+
+void
+journal_base_t::update_hash_key(void)
+{
+	sbarray_t file_id;
+
+	std::memcpy(&file_id[0], &m_file_id[0], file_id.size());
+	m_hash_key = siphash24_key(file_id);
+	return;
+}
+
 uint64_t
 journal_base_t::minimum_header_size(const object_t* obj) const
 {
@@ -247,7 +276,7 @@ journal_base_t::move_to_object(const object_type_t& type, const uint64_t offset,
 	object_t*   obj(nullptr);
 	std::size_t siz(0);
 
-	DEBUG("journal_base_t::move_to_object(): Moving to object of type: ", obj_hdr_t::type_string(type), " at offset: ", to_hex_string(offset));
+	DEBUG("journal_base_t::move_to_object(): Moving to object of type: ", object_type_string(type), " at offset: ", to_hex_string(offset));
 
 	if (nullptr == ret)
 		throw journal_parameter_error_t("journal_base_t::move_to_object(): Invalid parameter (nullptr)");
@@ -274,7 +303,18 @@ journal_base_t::move_to_object(const object_type_t& type, const uint64_t offset,
 	if (siz > m_size)
 		throw journal_invalid_logic_error_t("journal_base_t::move_to_object(): invalid object size encountered (>m_size)");
 
-	check_object(offset, obj);
+	/*
+	 * Entries reference the same DATA objects over and over, so unless in
+	 * strict mode the per-type validation runs once per object, tracked by
+	 * a bitmap indexed by the (64-bit aligned) offset / 8.
+	 */
+	if (true == m_strict || false == m_validated.test(offset / 8)) {
+		check_object(offset, obj);
+
+		if (false == m_strict)
+			m_validated.set(offset / 8);
+	}
+
 	*ret = obj;
 	return;
 }
@@ -282,7 +322,7 @@ journal_base_t::move_to_object(const object_type_t& type, const uint64_t offset,
 void
 journal_base_t::move_to(const object_type_t& type, const uint64_t offset, const uint64_t size, void** ret) const
 {
-	DEBUG("journal_base_t::move_to(): Moving to object of type: ", obj_hdr_t::type_string(type), " at offset: ", to_hex_string(offset));
+	DEBUG("journal_base_t::move_to(): Moving to object of type: ", object_type_string(type), " at offset: ", to_hex_string(offset));
 
 	if (size <= 0)
 		throw journal_invalid_logic_error_t("journal_base_t::move_to(): invalid size encountered (<=0)");
@@ -295,6 +335,15 @@ journal_base_t::move_to(const object_type_t& type, const uint64_t offset, const
 	return;
 }
 
+const object_t*
+journal_base_t::object_at(const object_type_t& type, const uint64_t offset) const
+{
+	object_t* obj(nullptr);
+
+	move_to_object(type, offset, &obj);
+	return obj;
+}
+
 const uint64_t
 journal_base_t::file_entry_n_items(const object_t* obj) const
 {
@@ -371,7 +420,7 @@ journal_base_t::file_entry_array_n_items(const object_t* obj) const
 
 
 journal_base_t::journal_base_t(void)
-	: m_ptr(nullptr), m_size(0), m_name(""), m_seal(false)
+	: m_ptr(nullptr), m_size(0), m_name(""), m_seal(false), m_strict(false)
 {
 	reset();
 
@@ -388,7 +437,7 @@ journal_base_t::journal_base_t(void)
 }
 
 journal_base_t::journal_base_t(const char* name)
-	: m_ptr(nullptr), m_size(0), m_name(name), m_seal(false)
+	: m_ptr(nullptr), m_size(0), m_name(name), m_seal(false), m_strict(false)
 {
 	if (nullptr == name)
 		throw journal_parameter_error_t("journal_base_t::journal_base_t(): invalid filename (null)");
@@ -408,7 +457,7 @@ journal_base_t::journal_base_t(const char* name)
 }
 
 journal_base_t::journal_base_t(const journal_base_t& other)
-	: m_ptr(nullptr), m_size(0), m_name(""), m_seal(false)
+	: m_ptr(nullptr), m_size(0), m_name(""), m_seal(false), m_strict(false)
 {
 	*this = other;
 	return;	
@@ -446,15 +495,22 @@ journal_base_t::operator=(const journal_base_t& other)
 	m_object_size_tbl[object_type_t::OBJECT_TAG] 				= other.m_object_size_tbl[object_type_t::OBJECT_TAG];
 
 	m_seal 														= other.m_seal;
-	m_data_objects 												= other.m_data_objects;
-	m_entry_objects 											= other.m_entry_objects;
-	m_field_objects 											= other.m_field_objects;
-	m_tag_objects 												= other.m_tag_objects;
+	m_strict													= other.m_strict;
+
+	copy_header(other);
+
+
+	return *this;
+}
 
+void
+journal_base_t::copy_header(const journal_base_t& other)
+{
 	m_compatible_flags 											= other.m_compatible_flags;
 	m_incompatible_flags 										= other.m_incompatible_flags;
 	m_state 													= other.m_state;
 	m_file_id 													= other.m_file_id;
+	m_hash_key 													= other.m_hash_key;
 	m_machine_id 												= other.m_machine_id;
 	m_boot_id 													= other.m_boot_id;
 	m_seqnum_id 												= other.m_seqnum_id;
@@ -479,9 +535,7 @@ journal_base_t::operator=(const journal_base_t& other)
 	m_n_entry_arrays 											= other.m_n_entry_arrays;
 	m_data_hash_chain_depth 									= other.m_data_hash_chain_depth;
 	m_field_hash_chain_depth 									= other.m_field_hash_chain_depth;
-
-
-	return *this;
+	return;
 }
 
 journal_base_t::~journal_base_t(void)
@@ -493,11 +547,6 @@ journal_base_t::~journal_base_t(void)
 void
 journal_base_t::reset(void)
 {
-	m_data_objects.clear();
-	m_entry_objects.clear();
-	m_field_objects.clear();
-	m_tag_objects.clear();
-
 	if (nullptr != m_ptr) 
 		dealloc();
 
@@ -508,6 +557,7 @@ journal_base_t::reset(void)
 	m_incompatible_flags		= 0;
 	m_state						= 0;
 	m_file_id					= {0,0};
+	update_hash_key();
 	m_machine_id				= {0,0};
 	m_boot_id					= {0,0};
 	m_seqnum_id					= {0,0};
@@ -565,6 +615,19 @@ journal_base_t::seal(const bool seal)
 	return;
 }
 
+bool
+journal_base_t::strict(void) const
+{
+	return m_strict;
+}
+
+void
+journal_base_t::strict(const bool strict)
+{
+	m_strict = strict;
+	return;
+}
+
 std::string
 journal_base_t::compatible_flags_string(void)
 {
@@ -664,6 +727,7 @@ journal_base_t::file_id(const uint128_vec_t& id)
 {
 	m_file_id[0] = id[0];
 	m_file_id[1] = id[1];
+	update_hash_key();
 	return;
 }
 
@@ -982,52 +1046,3 @@ journal_base_t::field_hash_chain_depth(const uint64_t& depth)
 	m_field_hash_chain_depth = depth;
 	return;
 }
-
-std::vector< data_obj_t >&
-journal_base_t::data_objects(void)
-{
-	return m_data_objects;
-}
-
-const std::size_t
-journal_base_t::data_objects_size(void) const
-{
-	return m_data_objects.size();
-}
-
-std::vector< entry_obj_t >&
-journal_base_t::entry_objects(void)
-{
-	return m_entry_objects;
-}
-
-const std::size_t
-journal_base_t::entry_objects_size(void) const
-{
-	return m_entry_objects.size();
-}
-
-std::vector< field_obj_t >&
-journal_base_t::field_objects(void)
-{
-	return m_field_objects;
-}
-
-const std::size_t
-journal_base_t::field_objects_size(void)
-{
-	return m_field_objects.size();
-}
-
-std::vector< tag_obj_t >&
-journal_base_t::tag_objects(void)
-{
-	return m_tag_objects;
-}
-
-const std::size_t
-journal_base_t::tag_objects_size(void) const
-{
-	return m_tag_objects.size();
-}
-
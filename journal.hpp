@@ -17,6 +17,9 @@
 #include "log.hpp"
 #include "siphash.hpp"
 #include "lookup3.hpp"
+#include "batch_hash.hpp"
+#include "bitmap.hpp"
+#include "trace.hpp"
 
 class journal_base_t
 {
@@ -27,16 +30,15 @@ class journal_base_t
 		std::string                 m_name;
         object_size_tbl_t           m_object_size_tbl;
         bool                        m_seal;
-        std::vector< data_obj_t >   m_data_objects;
-        std::vector< entry_obj_t >  m_entry_objects;
-        std::vector< field_obj_t >  m_field_objects;
-        std::vector< tag_obj_t >    m_tag_objects;
+		bool						m_strict;
+		mutable bitmap_t			m_validated;
 
 
 		uint32_t					m_compatible_flags;
 		uint32_t					m_incompatible_flags;
 		uint8_t						m_state;
 		uint128_vec_t				m_file_id;
+		siphash_key_t				m_hash_key;
 		uint128_vec_t				m_machine_id;
 		uint128_vec_t				m_boot_id;
 		uint128_vec_t				m_seqnum_id;
@@ -63,9 +65,9 @@ class journal_base_t
 		uint64_t					m_field_hash_chain_depth;
 
 		virtual bool alloc(const std::size_t);
+		virtual void update_hash_key(void);
 		virtual void dealloc(void);
 
-		virtual const uint64_t hash_data(const void*, const std::size_t) const;
 		virtual uint64_t minimum_header_size(const object_t*) const;
 		virtual void check_object(const uint64_t& offset, const object_t* obj) const;
 		virtual void move_to(const object_type_t&, const uint64_t, const uint64_t, void**) const;
@@ -82,17 +84,25 @@ class journal_base_t
 		journal_base_t(const journal_base_t&);
 
 		journal_base_t& operator=(const journal_base_t&);
+		virtual void copy_header(const journal_base_t&);
 		
 		virtual ~journal_base_t(void);
 		
 		virtual void reset(void);
 
+		virtual const object_t* object_at(const object_type_t&, const uint64_t) const;
+		virtual const uint64_t hash_data(const void*, const std::size_t) const;
+		virtual void hash_data(const hash_input_t*, const std::size_t, uint64_t*) const;
+
 		virtual std::string name(void) const;
 		virtual void name(const char*);
 
 		virtual bool seal(void) const;
 		virtual void seal(const bool);
 
+		virtual bool strict(void) const;
+		virtual void strict(const bool);
+
 		virtual std::string compatible_flags_string(void);
 		virtual std::string incompatible_flags_string(void);
 
@@ -181,17 +191,5 @@ class journal_base_t
 
 		virtual uint64_t field_hash_chain_depth(void) const;
 		virtual void field_hash_chain_depth(const uint64_t&);
-
-		virtual std::vector< data_obj_t >& data_objects(void);
-		virtual const std::size_t data_objects_size(void) const;
-
-		virtual std::vector< entry_obj_t >& entry_objects(void);
-		virtual const std::size_t entry_objects_size(void) const;
-
-		virtual std::vector< field_obj_t >& field_objects(void);
-		virtual const std::size_t field_objects_size(void);
-
-		virtual std::vector< tag_obj_t >& tag_objects(void);
-		virtual const std::size_t tag_objects_size(void) const;
 };
 
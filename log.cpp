@@ -60,6 +60,8 @@ logger_t::log_recursive(logging_priority_t priority, const char* file, int line,
 	else 
 		entry += std::string(file) + ':' + std::to_string(line) + " " + msg.str();
 
+	std::lock_guard< std::mutex > lck(m_mutex);
+
 	if (LOG_INFO_PROMPT == priority) {
 		std::cout << entry << std::flush;
 		return;
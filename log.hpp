@@ -7,6 +7,7 @@
 #include <sstream>
 #include <iostream>
 #include <ostream>
+#include <mutex>
 #include "global.hpp"
 
 extern params_t g_params;
@@ -23,7 +24,18 @@ typedef enum
 } logging_priority_t;
 
 
-#define DEBUG(...) logger_t::instance().log_wrapper(LOG_DEBUG, __FILE__, __LINE__, __VA_ARGS__)
+/*
+ * DEBUG() checks g_params.debug before any of its arguments are evaluated,
+ * so the string conversions in the hot paths cost nothing unless debugging
+ * is enabled. Building with ZAP_NO_DEBUG defined (make NODEBUG=1) removes
+ * the calls altogether; the arguments are still type checked.
+ */
+#ifdef ZAP_NO_DEBUG
+#define DEBUG(...) do { if (false) logger_t::instance().log_wrapper(LOG_DEBUG, __FILE__, __LINE__, __VA_ARGS__); } while (0)
+#else
+#define DEBUG(...) do { if (true == g_params.debug) logger_t::instance().log_wrapper(LOG_DEBUG, __FILE__, __LINE__, __VA_ARGS__); } while (0)
+#endif
+
 #define INFO(...)  logger_t::instance().log_wrapper(LOG_INFO, __FILE__, __LINE__, __VA_ARGS__)
 #define INFO_PROMPT(...) logger_t::instance().log_wrapper(LOG_INFO_PROMPT, __FILE__, __LINE__, __VA_ARGS__)
 #define ERROR(...) logger_t::instance().log_wrapper(LOG_ERROR, __FILE__, __LINE__, __VA_ARGS__)
@@ -36,6 +48,8 @@ class logger_t
 		logger_t(void) {}
 
 	protected:
+		std::mutex	m_mutex;
+
 		static inline std::string priority_to_string(const logging_priority_t& priority);
 
 	public:
@@ -451,7 +451,7 @@ jenkins_hash64_t::hashlittle2(const void* key, const std::size_t length, uint32_
 		const uint32_t* k(reinterpret_cast< const uint32_t* >(key)); /* read 32-bit chunks */
 
 		/*------ all but last block: aligned reads and affect 32 bits of (a,b,c) */
-		while (12 > len) {
+		while (12 < len) {
 			a += k[0];
 			b += k[1];
 			c += k[2];
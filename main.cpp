@@ -2,11 +2,18 @@
 #include <cstdint>
 #include <cstdlib>
 #include <list>
+#include <algorithm>
 #include <string.h>
 
 #include "global.hpp"
 #include "input_journal.hpp"
 #include "output_journal.hpp"
+#include "cursor.hpp"
+#include "merge.hpp"
+#include "filter.hpp"
+#include "value_index.hpp"
+#include "stats.hpp"
+#include "radix_sort.hpp"
 
 #define MIN_ARGS_COUNT 3
 
@@ -15,10 +22,25 @@ params_t g_params = {
 	std::string(""), 
 	std::vector< std::string >(), 
 	std::vector< std::string >(),
+	std::vector< std::string >(),
 	false, 
 	false, 
 	false, 
-	false 
+	false,
+	false,
+	false,
+	0,
+	false,
+	false,
+	false,
+	std::string(""),
+	false,
+	false,
+	std::string(""),
+	std::string(""),
+	false,
+	std::string(""),
+	std::vector< std::string >()
 };
 
 void
@@ -28,10 +50,24 @@ usage(const char* nm)
 								"[-o|--output-file] <output file> " 			\
 								"[-F|--field-name] <field specifier> " 			\
 								"[-V|--field-value] <filed value specifier>"    \
+								"[-D|--drop-field] <field specifier> " 			\
 								"[-p|--print-all] " 							\
 								"[-P|--print-matches] " 						\
                                 "[-c|--confirm-matches] " 						\
 								"[-y|--yes] " 									\
+								"[-s|--stream] " 								\
+								"[-r|--sort] <order> " 							\
+								"[-m|--merge] <input file> " 					\
+								"[-j|--threads] <count> " 						\
+								"[-I|--index] " 								\
+								"[-X|--value-index] " 							\
+								"[-S|--strict] " 								\
+								"[-L|--verify-level] <level> " 					\
+								"[-v|--verify-only] " 							\
+								"[-T|--timings] " 								\
+								"[-J|--stats-json] <file> " 					\
+								"[-t|--trace] <file> " 							\
+								"[-C|--counters] " 								\
 								"[-d|--debug]");
 
 	ERROR_NOLINE(" ");
@@ -39,10 +75,26 @@ usage(const char* nm)
 	ERROR_NOLINE("[-o|--output-file]  <output file>               Output journallog file (compulsory)");
 	ERROR_NOLINE("[-F|--field-name]   <field specifier>           Field specifier, may be supplied multiple times");
     ERROR_NOLINE("[-V|--field-value]  <field value specifier>     Field value specifier, may be supplied multiple times");
+    ERROR_NOLINE("[-D|--drop-field]   <field specifier>           Remove field from all log entries, may be supplied multiple times");
     ERROR_NOLINE("[-p|--print-all]                                Print all log entries");
     ERROR_NOLINE("[-P|--print-matches]                            Print all log entries that match selected criterion");
     ERROR_NOLINE("[-c|--confirm-matches]                          Confirm all matching log entries with the user");
     ERROR_NOLINE("[-y|--yes]                                      Response to all confirmation dialogues affirmatively automatically");
+    ERROR_NOLINE("[-s|--stream]                                   Stream entries from the mapped input without loading the whole log");
+    ERROR_NOLINE("[-r|--sort]         <order>                     Sort rewritten entries by seqnum or realtime (default: input order)");
+    ERROR_NOLINE("[-m|--merge]        <input file>                Merge another journal with the input file, ordered by --sort (default: realtime)");
+    ERROR_NOLINE("[-j|--threads]      <count>                     Number of threads used to decode objects (default: one per CPU)");
+    ERROR_NOLINE("[-I|--index]                                    Use (or create) an object offset index alongside the input file. The default level");
+    ERROR_NOLINE("                                                becomes structural, whose checks are made when the index is built; an index");
+    ERROR_NOLINE("                                                built at a weaker level than asked for is rebuilt");
+    ERROR_NOLINE("[-X|--value-index]                              Resolve criteria using (or creating) a field/value index alongside the input file");
+    ERROR_NOLINE("[-S|--strict]                                   Re-validate objects every time they are referenced");
+    ERROR_NOLINE("[-L|--verify-level] <level>                     Input verification: none, header, structural or full (default: full, structural with -I)");
+    ERROR_NOLINE("[-v|--verify-only]                              Verify the input file in parallel and report throughput; no output file is written");
+    ERROR_NOLINE("[-T|--timings]                                  Print per-phase timings, throughput, peak RSS and object counts");
+    ERROR_NOLINE("[-J|--stats-json]   <file>                      Write the same statistics to a file as JSON");
+    ERROR_NOLINE("[-t|--trace]        <file>                      Record per-thread trace events and write them in Chrome trace format");
+    ERROR_NOLINE("[-C|--counters]                                 Add hardware performance counters (cycles, IPC, misses, page faults) to the statistics");
 	ERROR_NOLINE("[-d|--debug]                                    Enable debugging");
 
 	_exit(EXIT_FAILURE);
@@ -87,6 +139,12 @@ parse_arguments(signed int ac, char** av)
 
 			g_params.field_values.push_back(av[++idx]);
 
+		} else if (! ::strncmp("-D", av[idx], ::strlen("-D")) || ! ::strncmp("--drop-field", av[idx], ::strlen("--drop-field"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.drop_fields.push_back(av[++idx]);
+
 		} else if (! ::strncmp("-p", av[idx], ::strlen("-p")) || ! ::strncmp("--print-all", av[idx], ::strlen("--print-all"))) {
 				g_params.print_all = true;
 
@@ -99,6 +157,63 @@ parse_arguments(signed int ac, char** av)
 		} else if (! ::strncmp("-y", av[idx], ::strlen("-y")) || ! ::strncmp("--yes", av[idx], ::strlen("--yes"))) {
 				g_params.yes = true;
 
+		} else if (! ::strncmp("-s", av[idx], ::strlen("-s")) || ! ::strncmp("--stream", av[idx], ::strlen("--stream"))) {
+			g_params.stream = true;
+
+		} else if (! ::strncmp("-r", av[idx], ::strlen("-r")) || ! ::strncmp("--sort", av[idx], ::strlen("--sort"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.sort_order = av[++idx];
+
+		} else if (! ::strncmp("-m", av[idx], ::strlen("-m")) || ! ::strncmp("--merge", av[idx], ::strlen("--merge"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.merge_files.push_back(av[++idx]);
+
+		} else if (! ::strncmp("-j", av[idx], ::strlen("-j")) || ! ::strncmp("--threads", av[idx], ::strlen("--threads"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.threads = static_cast< std::size_t >(std::strtoul(av[++idx], nullptr, 10));
+
+		} else if (! ::strncmp("-I", av[idx], ::strlen("-I")) || ! ::strncmp("--index", av[idx], ::strlen("--index"))) {
+			g_params.index = true;
+
+		} else if (! ::strncmp("-X", av[idx], ::strlen("-X")) || ! ::strncmp("--value-index", av[idx], ::strlen("--value-index"))) {
+			g_params.value_index = true;
+
+		} else if (! ::strncmp("-S", av[idx], ::strlen("-S")) || ! ::strncmp("--strict", av[idx], ::strlen("--strict"))) {
+			g_params.strict = true;
+
+		} else if (! ::strncmp("-L", av[idx], ::strlen("-L")) || ! ::strncmp("--verify-level", av[idx], ::strlen("--verify-level"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.verify_level = av[++idx];
+
+		} else if (! ::strncmp("-v", av[idx], ::strlen("-v")) || ! ::strncmp("--verify-only", av[idx], ::strlen("--verify-only"))) {
+			g_params.verify_only = true;
+
+		} else if (! ::strncmp("-T", av[idx], ::strlen("-T")) || ! ::strncmp("--timings", av[idx], ::strlen("--timings"))) {
+			g_params.timings = true;
+
+		} else if (! ::strncmp("-J", av[idx], ::strlen("-J")) || ! ::strncmp("--stats-json", av[idx], ::strlen("--stats-json"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.stats_json = av[++idx];
+
+		} else if (! ::strncmp("-t", av[idx], ::strlen("-t")) || ! ::strncmp("--trace", av[idx], ::strlen("--trace"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			g_params.trace_file = av[++idx];
+
+		} else if (! ::strncmp("-C", av[idx], ::strlen("-C")) || ! ::strncmp("--counters", av[idx], ::strlen("--counters"))) {
+			g_params.counters = true;
+
 		} else if (! ::strncmp("-d", av[idx], ::strlen("-d")) || ! ::strncmp("--debug", av[idx], ::strlen("--debug"))) {		
 			g_params.debug = true;
 
@@ -108,6 +223,39 @@ parse_arguments(signed int ac, char** av)
 		}
 	}
 
+	/*
+	 * A valid object index stands in for the walk over the input, which full
+	 * verification would make all over again, so unless asked otherwise
+	 * using one lowers the default level to the checks the index carries.
+	 */
+	if (true == g_params.verify_level.empty())
+		g_params.verify_level = (true == g_params.index ? "structural" : "full");
+
+	if (g_params.verify_level != "none" && g_params.verify_level != "header" && 
+		g_params.verify_level != "structural" && g_params.verify_level != "full") {
+		ERROR_NOLINE("Invalid verification level: ", g_params.verify_level);
+		usage(av[0]);
+	}
+
+	if (false == g_params.sort_order.empty() && g_params.sort_order != "seqnum" && g_params.sort_order != "realtime") {
+		ERROR_NOLINE("Invalid sort order: ", g_params.sort_order);
+		usage(av[0]);
+	}
+
+	if (true == g_params.stream && "realtime" == g_params.sort_order) {
+		ERROR_NOLINE("Streaming cannot be combined with sorting by realtime, which needs every entry at once");
+		usage(av[0]);
+	}
+
+	if (false == g_params.merge_files.empty() && (0 != g_params.fields.size() || 0 != g_params.field_values.size() || 
+		0 != g_params.drop_fields.size() || true == g_params.verify_only)) {
+		ERROR_NOLINE("Merging journals cannot be combined with field criteria or verification only");
+		usage(av[0]);
+	}
+
+	if (true == g_params.verify_only && false == g_params.input_file.empty())
+		return;
+
 	if (true == g_params.input_file.empty() || true == g_params.output_file.empty()) {
 		ERROR_NOLINE("No input or output file specified");
 		usage(av[0]);
@@ -130,126 +278,408 @@ read_yn(void)
 	return true;
 }
 
+/*
+ * Writes every surviving entry straight to the output, or, when a sort 
+ * order is set, only records a pointer to it in the mapping and its key;
+ * flush() then radix sorts the keys and writes the entries in that order.
+ */
+class rewrite_sink_t : public entry_sink_t
+{
+	private:
+	protected:
+		output_journal_t&				m_output;
+		const std::vector< uint64_t >&	m_drop;
+		bool							m_defer;
+		entry_order_t					m_order;
+		std::vector< const object_t* >	m_entries;
+		std::vector< sort_key_t >		m_keys;
+
+	public:
+		std::size_t						matches;
+		std::size_t						deleted;
+		std::size_t						dropped;
+
+		rewrite_sink_t(output_journal_t& oj, const std::vector< uint64_t >& drop) 
+			: entry_sink_t(), m_output(oj), m_drop(drop), m_defer(false), m_order(ORDER_SEQNUM), matches(0), deleted(0), dropped(0) 
+		{ 
+			return; 
+		}
+
+		virtual void
+		order(const entry_order_t o)
+		{
+			m_defer = true;
+			m_order = o;
+			return;
+		}
+
+		virtual void
+		flush(const journal_base_t& src, thread_pool_t* pool)
+		{
+			TRACE_SCOPE("rewrite_sink_t::flush");
+
+			radix_sort_t::sort(m_keys, pool);
+
+			for (std::size_t idx = 0; idx < m_keys.size(); idx++)
+				if (false == m_output.write_entry(src, m_entries[m_keys[idx].index], m_drop))
+					dropped++;
+
+			m_entries.clear();
+			m_keys.clear();
+			return;
+		}
+
+		virtual ~rewrite_sink_t(void) 
+		{ 
+			return; 
+		}
+
+		virtual void 
+		entry(const journal_base_t& src, const object_t* obj, const bool match)
+		{
+			if (true == g_params.print_all)
+				INFO(entry_cursor_t::to_string(src, obj));
+
+			if (true == match) {
+				matches++;
+
+				if (true == g_params.confirm_matches) {
+					INFO("MATCH: ", entry_cursor_t::to_string(src, obj));
+					INFO_PROMPT("Delete? (Y/n): ");
+
+					if (true == read_yn()) {
+						INFO("Deleting match");
+						deleted++;
+						return;
+					}
+
+					INFO("Skipping match");
+				} else {
+					if (true == g_params.print_matches)
+						INFO("MATCH: ", entry_cursor_t::to_string(src, obj));
+
+					deleted++;
+					return;
+				}
+			}
+
+			if (true == m_defer) {
+				const sort_key_t key = { get_uint64(ORDER_REALTIME == m_order ? obj->entry.realtime : obj->entry.seqnum), 
+											static_cast< uint32_t >(m_entries.size()) };
+
+				if (m_entries.size() >= std::numeric_limits< uint32_t >::max())
+					throw journal_overflow_error_t("rewrite_sink_t::entry(): too many entries to sort");
+
+				m_entries.push_back(obj);
+				m_keys.push_back(key);
+				return;
+			}
+
+			if (false == m_output.write_entry(src, obj, m_drop))
+				dropped++;
+
+			return;
+		}
+};
+
+template< typename T > bool
+resolve_criteria(const T& ij, hash_filter_t& filter, std::vector< uint64_t >& drop_hashes)
+{
+	if (0 != g_params.fields.size()) {
+		const std::size_t fnmax(g_params.fields.size());
+
+		/*
+		 * Entry items carry the hashes of their DATA objects, never that of
+		 * a FIELD, so a field selects every entry holding any of its values.
+		 */
+		INFO("Locating specified fields");
+		for (std::size_t idx = 0; idx < fnmax; idx++) {
+			std::vector< uint64_t > hashes;
+
+			if (false == ij.get_field_data_hashes(g_params.fields[idx], hashes)) {
+				ERROR("No such field located: ", g_params.fields[idx], " typo?");
+				return false;
+			}
+
+			filter.add(hashes);
+		}
+	}
+
+	if (0 != g_params.field_values.size()) {
+		const std::size_t fvmax(g_params.field_values.size());
+
+		INFO("Locating specified field values");
+		for (std::size_t idx = 0; idx < fvmax; idx++) {
+			uint64_t hash(0);
+
+			if (false == ij.find_field_value_hash(g_params.field_values[idx], hash)) {
+				ERROR("No such field value located: ", g_params.field_values[idx], " typo?");
+				return false;
+			}
+
+			filter.add(hash);
+		}
+	}
+
+	if (0 != g_params.drop_fields.size()) {
+		const std::size_t dfmax(g_params.drop_fields.size());
+
+		INFO("Locating fields to drop");
+		for (std::size_t idx = 0; idx < dfmax; idx++) {
+			if (false == ij.get_field_data_hashes(g_params.drop_fields[idx], drop_hashes)) {
+				ERROR("No such field located: ", g_params.drop_fields[idx], " typo?");
+				return false;
+			}
+		}
+
+		std::sort(drop_hashes.begin(), drop_hashes.end());
+		drop_hashes.erase(std::unique(drop_hashes.begin(), drop_hashes.end()), drop_hashes.end());
+		INFO(drop_hashes.size(), " field values identified for removal");
+	}
+
+	return true;
+}
+
+static void
+report_stats(stats_t& stats, const journal_base_t& in, const journal_base_t* out)
+{
+	stats.counter("input_entries", in.n_entries());
+	stats.counter("input_objects", in.n_objects());
+	stats.counter("input_data_objects", in.n_data());
+	stats.counter("input_field_objects", in.n_fields());
+	stats.counter("input_data_hash_chain_depth", in.data_hash_chain_depth());
+	stats.counter("input_field_hash_chain_depth", in.field_hash_chain_depth());
+
+	if (nullptr != out) {
+		stats.counter("output_entries", out->n_entries());
+		stats.counter("output_objects", out->n_objects());
+		stats.counter("output_data_objects", out->n_data());
+		stats.counter("output_field_objects", out->n_fields());
+		stats.counter("output_data_hash_chain_depth", out->data_hash_chain_depth());
+		stats.counter("output_field_hash_chain_depth", out->field_hash_chain_depth());
+	}
+
+	if (true == g_params.timings)
+		stats.print();
+
+	if (false == g_params.stats_json.empty() && false == stats.write_json(g_params.stats_json))
+		ERROR("Unable to write statistics: ", g_params.stats_json);
+
+	return;
+}
+
+static signed int
+merge_journals(stats_t& stats)
+{
+	journal_merge_t		merge("seqnum" == g_params.sort_order ? ORDER_SEQNUM : ORDER_REALTIME);
+	output_journal_t	oj;
+	input_journal_t		tmp;
+	uint64_t			written(0);
+
+	merge.strict(g_params.strict);
+	oj.strict(g_params.strict);
+	tmp.strict(g_params.strict);
+	tmp.threads(g_params.threads);
+
+	INFO("Mapping ", g_params.merge_files.size() + 1, " input files");
+	stats.begin("map");
+	merge.open(g_params.input_file.c_str());
+
+	for (std::size_t idx = 0; idx < g_params.merge_files.size(); idx++)
+		merge.open(g_params.merge_files[idx].c_str());
+
+	stats.end(0, merge.n_bytes());
+
+	oj.copy_header(merge.input(0));
+	oj.name(g_params.output_file.c_str());
+	oj.size_hint(merge.n_bytes());
+	oj.begin_write();
+
+	INFO("Merging entries into rewritten log");
+	stats.begin("merge");
+	written = merge.merge(oj);
+	stats.end(written, merge.n_bytes());
+	INFO(written, " entries merged from ", merge.size(), " files");
+
+	INFO("Rewriting merged log to disk");
+	stats.begin("write");
+	oj.end_write();
+	stats.end(oj.n_objects(), oj.header_size() + oj.arena_size());
+
+	INFO("Verifiying written log file");
+	stats.begin("verify_output");
+	(void)tmp.verify(g_params.output_file.c_str());
+	stats.end(tmp.n_objects(), tmp.header_size() + tmp.arena_size());
+
+	stats.counter("merged_files", merge.size());
+	stats.counter("merged_entries", written);
+	report_stats(stats, merge.input(0), &oj);
+	return EXIT_SUCCESS;
+}
+
 signed int
 main(signed int ac, char** av)
 {
 	signed int 				retval(EXIT_SUCCESS);
-	std::vector< uint64_t > hashes, xor_hashes;
+	std::vector< uint64_t > drop_hashes;
 
 	parse_arguments(ac, av);
 
+	trace_file_t trace(g_params.trace_file);
+
 	try {
 		input_journal_t 	ij;
+		input_journal_t		tmp;
+		output_journal_t	oj;
+		hash_filter_t		hfilter;
+		seqnum_filter_t		sfilter;
+		value_index_t		vidx;
+		entry_filter_t*		filter(&hfilter);
+		rewrite_sink_t		sink(oj, drop_hashes);
+		stats_t				stats;
+		perf_counters_t		perf;
+
+		/* opened before any worker thread exists so that they inherit the counters */
+		if (true == g_params.counters) {
+			if (true == perf.open())
+				stats.counters(&perf);
+			else
+				ERROR("Performance counters are unavailable (perf_event_open failed)");
+		}
 
-		INFO("Parsing input file");
-		ij.parse(g_params.input_file.c_str());
+		ij.threads(g_params.threads);
+		tmp.threads(g_params.threads);
+		ij.strict(g_params.strict);
+		oj.strict(g_params.strict);
+		tmp.strict(g_params.strict);
 
-		if (0 != g_params.fields.size()) {
-			const std::size_t       fnmax(g_params.fields.size());
+		if ("none" == g_params.verify_level)
+			ij.verify_level(VERIFY_NONE);
+		else if ("header" == g_params.verify_level)
+			ij.verify_level(VERIFY_HEADER);
+		else if ("structural" == g_params.verify_level)
+			ij.verify_level(VERIFY_STRUCTURAL);
 
-			INFO("Locating specified fields");
-			for (std::size_t idx = 0; idx < fnmax; idx++) {
-				
-				if (true == ij.has_field(g_params.fields[idx])) {
-					const uint64_t hash(ij.get_field_hash(g_params.fields[idx]));
-					
-					hashes.push_back(hash);
-				} else {
-					ERROR("No such field located: ", g_params.fields[idx], " typo?");
-					return EXIT_FAILURE;
-				}
-			}
+		if (true == g_params.verify_only) {
+			uint64_t nobjects(0), nbytes(0), usec(0);
+
+			INFO("Verifying input file");
+			stats.begin("verify");
+			nobjects 	= ij.verify(g_params.input_file.c_str());
+			nbytes		= ij.header_size() + ij.arena_size();
+			stats.end(nobjects, nbytes);
+
+			usec = std::max< uint64_t >(stats.phases().back().usec, 1);
+
+			INFO("PASS: ", g_params.input_file);
+			INFO(nobjects, " objects (", nbytes, " bytes) verified in ", usec, "us: ", 
+					(nbytes * 1000000 / usec) / (1024 * 1024), " MiB/s, ", nobjects * 1000000 / usec, " objects/s");
+
+			report_stats(stats, ij, nullptr);
+			return EXIT_SUCCESS;
 		}
 
-		if (0 != g_params.field_values.size()) {
-			const std::size_t fvmax(g_params.field_values.size());
-		
-			INFO("Locating specified field values");
-			for (std::size_t idx = 0; idx < fvmax; idx++) {
-				if (true == ij.has_field_value(g_params.field_values[idx])) {
-					const uint64_t hash(ij.get_field_value_hash(g_params.field_values[idx]));
+		if (false == g_params.merge_files.empty())
+			return merge_journals(stats);
 
-					hashes.push_back(hash);
-				} else {
-					ERROR("No such field value located: ", g_params.field_values[idx], " typo?");
+		if (true == g_params.index)
+			ij.index_file(g_params.input_file + OBJECT_INDEX_SUFFIX);
+
+		INFO("Mapping input file");
+		stats.begin("map");
+		ij.open(g_params.input_file.c_str());
+		stats.end(0, ij.header_size() + ij.arena_size());
+
+		stats.begin("criteria");
+
+		if (true == g_params.value_index) {
+			const std::string 	vname(g_params.input_file + VALUE_INDEX_SUFFIX);
+			std::vector< uint64_t >	seqnums;
+
+			if (false == vidx.load(vname, ij.file_id(), ij.tail_entry_seqnum())) {
+				INFO("Building field/value index");
+
+				if (false == value_index_t::build(vname, ij) || false == vidx.load(vname, ij.file_id(), ij.tail_entry_seqnum())) {
+					ERROR("Unable to create field/value index: ", vname);
 					return EXIT_FAILURE;
 				}
 			}
-		}
 
-		{
-			const std::size_t 			hmax(hashes.size());
-			const std::size_t 			emax(ij.entry_objects_size());
-			std::vector< entry_obj_t >& entries(ij.entry_objects());
+			if (false == resolve_criteria(vidx, hfilter, drop_hashes))
+				return EXIT_FAILURE;
 
-			INFO("Seaching for matches to specified criterion");
-			for (std::size_t hidx = 0; hidx < hmax; hidx++) {
-				for (std::size_t eidx = 0; eidx < emax; eidx++) {
-					entry_obj_t& eobj(entries[eidx]);
+			for (std::size_t idx = 0; idx < hfilter.hashes().size(); idx++)
+				vidx.get_postings(hfilter.hashes()[idx], seqnums);
 
-					if (true == eobj.has_item_hash(hashes[hidx])) 
-						xor_hashes.push_back(eobj.xor_hash());
-				}
-			}
+			sfilter.add(seqnums);
+			filter = &sfilter;
+			INFO(sfilter.size(), " entries selected by field/value index");
+
+		} else if (false == resolve_criteria(ij, hfilter, drop_hashes))
+			return EXIT_FAILURE;
+
+		stats.end();
+
+		/* a stream comes in seqnum order already and is never buffered */
+		if ("seqnum" == g_params.sort_order && false == g_params.stream)
+			sink.order(ORDER_SEQNUM);
+		else if ("realtime" == g_params.sort_order)
+			sink.order(ORDER_REALTIME);
 
+		oj.copy_header(ij);
+		oj.name(g_params.output_file.c_str());
+		oj.size_hint(ij.header_size() + ij.arena_size());
+		oj.begin_write();
+		stats.begin("rewrite");
+
+		if (true == g_params.stream) {
+			entry_cursor_t cursor(ij);
+
+			/* the objects the cursor visits are checked on the way, see check_object() */
+			ij.verify_input();
+
+			INFO("Streaming entries into rewritten log");
+			while (true == cursor.next()) 
+				sink.entry(ij, cursor.object(), filter->match(cursor.object()));
+
+		} else {
+			/*
+			 * The criteria are pushed down into the parser: entries are 
+			 * classified during the object pass and forwarded to the writer
+			 * directly rather than being materialized and matched afterwards.
+			 */
+			INFO("Parsing input file and rewriting log into memory");
+			ij.parse(*filter, sink);
 		}
 
-		INFO(xor_hashes.size(), " matches identified");
-		{
-			const std::size_t 					xmax(xor_hashes.size());
-			std::vector< entry_obj_t >& 		evec(ij.entry_objects());
-			std::list< entry_obj_t >			entries(evec.begin(), evec.end());
-			std::list< entry_obj_t >::iterator 	itr(entries.begin());
-
-			INFO("Removing matches");
-			for (std::size_t idx = 0; idx < xmax; idx++) {
-				std::list< entry_obj_t >::iterator itr(entries.begin());
-
-				while (itr != entries.end()) {
-					entry_obj_t& eobj(*itr);
-					
-					if (true == g_params.print_all)
-						INFO(eobj.to_string());
-
-					if (xor_hashes[idx] == eobj.xor_hash()) {
-						if (true == g_params.confirm_matches) {
-							INFO("MATCH: ", eobj.to_string());
-							INFO_PROMPT("Delete? (Y/n): ");
-							if (true == read_yn()) {
-								INFO("Deleting match");
-								itr = entries.erase(itr);
-							} else {
-								INFO("Skipping match");
-								itr++;
-							}
-							continue;
-						} 
-
-						if (true == g_params.print_matches) {
-							INFO("MATCH: ", eobj.to_string());
-						}
-				
-						itr = entries.erase(itr);	
-					} else
-						itr++;
-				}
-			}
+		if (false == g_params.sort_order.empty()) {
+			thread_pool_t pool(g_params.threads);
 
-			{	
-				output_journal_t oj(ij);
-				input_journal_t  tmp;
-				
-				oj.name(g_params.output_file.c_str());
-				INFO("Rewriting modified log into memory");
-				oj.update(entries);
-				INFO("Rewriting modified log to disk");
-				oj.write();
-				INFO("Verifiying written log file");
-				tmp.name(g_params.output_file.c_str());
-				ij.parse(g_params.output_file.c_str());
-			}
+			INFO("Sorting rewritten entries by ", g_params.sort_order);
+			sink.flush(ij, &pool);
 		}
 
+		stats.end(ij.n_entries(), ij.header_size() + ij.arena_size());
+		INFO(sink.matches, " matches identified, ", sink.deleted, " removed");
+
+		if (0 != sink.dropped)
+			INFO(sink.dropped, " entries consisting solely of dropped fields removed");
+
+		INFO("Rewriting modified log to disk");
+		stats.begin("write");
+		oj.end_write();
+		stats.end(oj.n_objects(), oj.header_size() + oj.arena_size());
+
+		INFO("Verifiying written log file");
+		stats.begin("verify_output");
+		(void)tmp.verify(g_params.output_file.c_str());
+		stats.end(tmp.n_objects(), tmp.header_size() + tmp.arena_size());
+
+		stats.counter("matches", sink.matches);
+		stats.counter("deleted", sink.deleted);
+		stats.counter("dropped", sink.dropped);
+		report_stats(stats, ij, &oj);
+
 	} catch (std::exception& e)
 	{
 		ERROR_NOLINE("Exception Caught: ", e.what());
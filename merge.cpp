@@ -0,0 +1,194 @@
+#include "merge.hpp"
+
+journal_merge_t::journal_merge_t(const entry_order_t order)
+	: m_order(order), m_strict(false)
+{
+	if (ORDER_MAX <= order)
+		throw journal_parameter_error_t("journal_merge_t::journal_merge_t(): invalid entry order");
+
+	return;
+}
+
+journal_merge_t::~journal_merge_t(void)
+{
+	for (std::size_t idx = 0; idx < m_cursors.size(); idx++)
+		delete m_cursors[idx];
+
+	for (std::size_t idx = 0; idx < m_inputs.size(); idx++)
+		delete m_inputs[idx];
+
+	m_cursors.clear();
+	m_inputs.clear();
+	return;
+}
+
+void
+journal_merge_t::strict(const bool s)
+{
+	m_strict = s;
+	return;
+}
+
+void
+journal_merge_t::open(const char* name)
+{
+	input_journal_t* ij(nullptr);
+
+	if (nullptr == name)
+		throw journal_parameter_error_t("journal_merge_t::open(): invalid parameter (nullptr)");
+
+	ij = new input_journal_t;
+	ij->strict(m_strict);
+
+	try {
+		ij->open(name);
+	} catch (...) {
+		delete ij;
+		throw;
+	}
+
+	/*
+	 * Payloads are copied verbatim and the output takes its header from the
+	 * first input, so every input has to agree on compression and on the
+	 * hash function in use.
+	 */
+	if (0 != m_inputs.size() && m_inputs[0]->incompatible_flags() != ij->incompatible_flags()) {
+		delete ij;
+		throw journal_invalid_logic_error_t("journal_merge_t::open(): input journals have differing incompatible flags");
+	}
+
+	m_inputs.push_back(ij);
+	m_cursors.push_back(new entry_cursor_t(*ij));
+	return;
+}
+
+const std::size_t
+journal_merge_t::size(void) const
+{
+	return m_inputs.size();
+}
+
+const input_journal_t&
+journal_merge_t::input(const std::size_t idx) const
+{
+	if (idx >= m_inputs.size())
+		throw std::out_of_range("journal_merge_t::input(): index out of range");
+
+	return *m_inputs[idx];
+}
+
+const uint64_t
+journal_merge_t::n_entries(void) const
+{
+	uint64_t ret(0);
+
+	for (std::size_t idx = 0; idx < m_inputs.size(); idx++)
+		ret += m_inputs[idx]->n_entries();
+
+	return ret;
+}
+
+const uint64_t
+journal_merge_t::n_bytes(void) const
+{
+	uint64_t ret(0);
+
+	for (std::size_t idx = 0; idx < m_inputs.size(); idx++)
+		ret += m_inputs[idx]->header_size() + m_inputs[idx]->arena_size();
+
+	return ret;
+}
+
+const uint64_t
+journal_merge_t::key(const object_t* obj) const
+{
+	return get_uint64(ORDER_REALTIME == m_order ? obj->entry.realtime : obj->entry.seqnum);
+}
+
+void
+journal_merge_t::advance(const std::size_t idx)
+{
+	if (true == m_cursors[idx]->next()) {
+		const merge_head_t head = { key(m_cursors[idx]->object()), idx };
+
+		m_heap.push(head);
+	}
+
+	return;
+}
+
+/*
+ * Hashes stored in a DATA object can be reused by the output as long as both
+ * files hash alike: unkeyed files all use jenkins, while keyed files key
+ * siphash with their file id.
+ */
+const bool
+journal_merge_t::shares_hashes(const journal_base_t& src, const journal_base_t& dst) const
+{
+	if (! JOURNAL_HEADER_KEYED_HASH(dst.incompatible_flags()))
+		return true;
+
+	return src.file_id() == dst.file_id();
+}
+
+void
+journal_merge_t::rehash_entry(output_journal_t& oj, const entry_cursor_t& cursor)
+{
+	const object_t*				entry(cursor.object());
+	const uint64_t				n_items(cursor.n_items());
+	std::vector< hash_input_t >	payloads(n_items);
+	uint128_vec_t				boot_id;
+
+	for (uint64_t idx = 0; idx < n_items; idx++) {
+		const object_t* dobj(cursor.item(idx));
+
+		if (0 != (dobj->object.flags & OBJECT_COMPRESSION_MASK))
+			throw journal_invalid_logic_error_t("journal_merge_t::rehash_entry(): compressed payloads cannot be rehashed");
+
+		payloads[idx].data = &dobj->data.payload[0];
+		payloads[idx].size = get_uint64(dobj->object.size) - offsetof(data_object_t, payload);
+	}
+
+	boot_id[0] = get_uint64(entry->entry.boot_id[0]);
+	boot_id[1] = get_uint64(entry->entry.boot_id[1]);
+
+	oj.write_entry(get_uint64(entry->entry.realtime), get_uint64(entry->entry.monotonic), boot_id, payloads.data(), payloads.size());
+	return;
+}
+
+const uint64_t
+journal_merge_t::merge(output_journal_t& oj)
+{
+	TRACE_SCOPE("journal_merge_t::merge");
+
+	const std::vector< uint64_t >	none;
+	std::vector< bool >				shared(m_inputs.size());
+	uint64_t						written(0);
+
+	for (std::size_t idx = 0; idx < m_inputs.size(); idx++) {
+		shared[idx] = shares_hashes(*m_inputs[idx], oj);
+
+		if (false == shared[idx])
+			DEBUG("Rehashing entries of ", m_inputs[idx]->name(), " for the output hash key");
+
+		m_cursors[idx]->reset();
+		advance(idx);
+	}
+
+	while (false == m_heap.empty()) {
+		const std::size_t	idx(m_heap.top().input);
+		entry_cursor_t&		cursor(*m_cursors[idx]);
+
+		m_heap.pop();
+
+		if (true == shared[idx])
+			oj.write_entry(*m_inputs[idx], cursor.object(), none);
+		else
+			rehash_entry(oj, cursor);
+
+		written++;
+		advance(idx);
+	}
+
+	return written;
+}
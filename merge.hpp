@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <queue>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "object.hpp"
+#include "journal-def.hpp"
+#include "journal.hpp"
+#include "input_journal.hpp"
+#include "output_journal.hpp"
+#include "cursor.hpp"
+#include "endian.hpp"
+#include "trace.hpp"
+#include "log.hpp"
+
+typedef struct {
+	uint64_t	key;
+	std::size_t	input;
+} merge_head_t;
+
+/*
+ * Orders the heap so that the smallest key is on top; ties go to the input
+ * that was opened first, which keeps the merge stable.
+ */
+class merge_head_compare_t
+{
+	public:
+		inline bool
+		operator()(const merge_head_t& a, const merge_head_t& b) const
+		{
+			if (a.key != b.key)
+				return a.key > b.key;
+
+			return a.input > b.input;
+		}
+};
+
+/*
+ * Merges the entries of several journals into one output journal. Every
+ * input is only mapped and walked with its own entry cursor, and a heap
+ * holds the current entry of each cursor, so no more than one entry per
+ * input is referenced at any time. DATA and FIELD objects shared between
+ * inputs are written once because the output deduplicates them through its
+ * hash tables.
+ *
+ * Each input is walked in sequence number order; when merging by realtime
+ * the output is only fully ordered if the clock did not step backwards
+ * within an input, as is the case for the rotated files of one system.
+ */
+class journal_merge_t
+{
+	private:
+		journal_merge_t(const journal_merge_t&)				= delete;
+		journal_merge_t& operator=(const journal_merge_t&)	= delete;
+
+	protected:
+		std::vector< input_journal_t* >	m_inputs;
+		std::vector< entry_cursor_t* >	m_cursors;
+		entry_order_t					m_order;
+		bool							m_strict;
+		std::priority_queue< merge_head_t, std::vector< merge_head_t >, merge_head_compare_t > m_heap;
+
+		virtual const uint64_t key(const object_t*) const;
+		virtual void advance(const std::size_t);
+		virtual const bool shares_hashes(const journal_base_t&, const journal_base_t&) const;
+		virtual void rehash_entry(output_journal_t&, const entry_cursor_t&);
+
+	public:
+		journal_merge_t(const entry_order_t order = ORDER_REALTIME);
+		virtual ~journal_merge_t(void);
+
+		virtual void strict(const bool);
+		virtual void open(const char*);
+
+		virtual const std::size_t size(void) const;
+		virtual const input_journal_t& input(const std::size_t) const;
+		virtual const uint64_t n_entries(void) const;
+		virtual const uint64_t n_bytes(void) const;
+
+		virtual const uint64_t merge(output_journal_t&);
+};
@@ -0,0 +1,512 @@
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <unistd.h>
+
+#include "global.hpp"
+#include "siphash.hpp"
+#include "lookup3.hpp"
+#include "batch_hash.hpp"
+#include "input_journal.hpp"
+#include "output_journal.hpp"
+#include "cursor.hpp"
+#include "filter.hpp"
+#include "perf.hpp"
+
+/*
+ * The microbenchmarks share the journal code with zap and thus its
+ * logging, which only ever consults the debug flag.
+ */
+params_t g_params = params_t();
+
+typedef struct {
+	std::vector< std::size_t >	sizes;
+	std::vector< std::string >	benches;
+	uint64_t					min_usec;
+	bool						counters;
+} micro_params_t;
+
+static micro_params_t micro_params = {
+	std::vector< std::size_t >(),
+	std::vector< std::string >(),
+	200000,
+	false
+};
+
+static perf_counters_t micro_perf;
+
+/* results are folded into this so no benchmarked call can be optimised away */
+static volatile uint64_t sink(0);
+
+/* the kernels under test are protected members; expose them to the benchmarks */
+class micro_output_journal_t : public output_journal_t
+{
+	public:
+		using output_journal_t::append_data;
+};
+
+void
+usage(const char* nm)
+{
+	ERROR_NOLINE("Usage: ", nm, " [-s|--sizes] <size,...> "		\
+								"[-b|--bench] <name> "			\
+								"[-t|--time] <msec> "			\
+								"[-C|--counters] "				\
+								"[-h|--help]");
+
+	ERROR_NOLINE(" ");
+	ERROR_NOLINE("[-s|--sizes] <size,...>    Payload sizes in bytes (default: 16,64,256,1024,4096,65536)");
+	ERROR_NOLINE("[-b|--bench] <name>        Only run benchmarks whose name contains this, may be supplied multiple times");
+	ERROR_NOLINE("[-t|--time]  <msec>        Minimum run time per benchmark and size (default: 200)");
+	ERROR_NOLINE("[-C|--counters]            Add hardware performance counters per operation");
+	ERROR_NOLINE(" ");
+	ERROR_NOLINE("Benchmarks: jenkins, jenkins_batch, siphash_t, siphash24, siphash24_batch, append_data_new, append_data_dup, "	\
+				  "field_value_scan, object_at, object_at_strict, cursor_next, filter_match");
+
+	_exit(EXIT_FAILURE);
+	return;
+}
+
+void
+parse_arguments(signed int ac, char** av)
+{
+	std::size_t cnt(static_cast< std::size_t >(ac));
+
+	if (0 > ac) {
+		throw std::runtime_error("::parse_arguments(): invalid/impossible negative argc encountered");
+		_exit(EXIT_FAILURE);
+	}
+
+	for (std::size_t idx = 1; idx < cnt; idx++) {
+		if (! ::strncmp("-s", av[idx], ::strlen("-s")) || ! ::strncmp("--sizes", av[idx], ::strlen("--sizes"))) {
+			std::istringstream 	list;
+			std::string			item("");
+
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			list.str(av[++idx]);
+
+			while (std::getline(list, item, ',')) {
+				const std::size_t size(static_cast< std::size_t >(std::strtoul(item.c_str(), nullptr, 10)));
+
+				if (0 == size) {
+					ERROR_NOLINE("Invalid payload size: ", item);
+					usage(av[0]);
+				}
+
+				micro_params.sizes.push_back(size);
+			}
+
+		} else if (! ::strncmp("-b", av[idx], ::strlen("-b")) || ! ::strncmp("--bench", av[idx], ::strlen("--bench"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			micro_params.benches.push_back(av[++idx]);
+
+		} else if (! ::strncmp("-t", av[idx], ::strlen("-t")) || ! ::strncmp("--time", av[idx], ::strlen("--time"))) {
+			if (idx+1 >= cnt)
+				usage(av[0]);
+
+			micro_params.min_usec = std::strtoull(av[++idx], nullptr, 10) * 1000;
+
+		} else if (! ::strncmp("-C", av[idx], ::strlen("-C")) || ! ::strncmp("--counters", av[idx], ::strlen("--counters"))) {
+			micro_params.counters = true;
+
+		} else {
+			if (::strncmp("-h", av[idx], ::strlen("-h")) && ::strncmp("--help", av[idx], ::strlen("--help")))
+				ERROR_NOLINE("Invalid parameter: ", av[idx]);
+
+			usage(av[0]);
+		}
+	}
+
+	if (true == micro_params.sizes.empty())
+		micro_params.sizes = { 16, 64, 256, 1024, 4096, 65536 };
+
+	return;
+}
+
+static bool
+selected(const std::string& name)
+{
+	if (true == micro_params.benches.empty())
+		return true;
+
+	for (std::size_t idx = 0; idx < micro_params.benches.size(); idx++)
+		if (std::string::npos != name.find(micro_params.benches[idx]))
+			return true;
+
+	return false;
+}
+
+/*
+ * Runs fn(iterations) with a doubling iteration count until a run takes at
+ * least the minimum time (or max_ops iterations were reached), then reports
+ * the last run. fn must perform exactly that many operations of the given
+ * number of bytes each. setup(iterations), if given, is called before each
+ * run and is not timed.
+ */
+static void
+run(const std::string& name, const std::size_t size, const uint64_t max_ops, std::function< void(const uint64_t) > setup, std::function< void(const uint64_t) > fn)
+{
+	std::ostringstream 	line;
+	uint64_t			ops(1), usec(0);
+	double				nsop(0.0), mbps(0.0);
+	perf_sample_t		before, after, counts;
+
+	if (false == selected(name))
+		return;
+
+	while (true) {
+		if (nullptr != setup)
+			setup(ops);
+
+		const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+		micro_perf.read(before);
+		fn(ops);
+		micro_perf.read(after);
+
+		usec = std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - start).count();
+
+		if (usec >= micro_params.min_usec || ops >= max_ops)
+			break;
+
+		ops = std::min(ops * 2, max_ops);
+	}
+
+	nsop = (static_cast< double >(usec) * 1000) / ops;
+	mbps = (0 == usec ? 0.0 : (static_cast< double >(size) * ops) / usec);
+
+	line << std::left << std::setw(18) << name << std::right << std::setw(8) << size
+		 << std::fixed << std::setprecision(1) << std::setw(14) << nsop << " ns/op"
+		 << std::setw(12) << mbps << " MB/s";
+
+	perf_counters_t::delta(before, after, counts);
+
+	if (true == counts.valid[PERF_CYCLES] && true == counts.valid[PERF_INSTRUCTIONS] && 0 != counts.value[PERF_CYCLES])
+		line << std::setprecision(2) << "  IPC " << static_cast< double >(counts.value[PERF_INSTRUCTIONS]) / counts.value[PERF_CYCLES];
+
+	for (std::size_t idx = 0; idx < PERF_COUNTER_MAX; idx++)
+		if (true == counts.valid[idx])
+			line << std::setprecision(2) << "  " << perf_counters_t::name(static_cast< perf_counter_t >(idx)) << "/op "
+				 << static_cast< double >(counts.value[idx]) / ops;
+
+	INFO(line.str());
+	return;
+}
+
+static void
+run(const std::string& name, const std::size_t size, const uint64_t max_ops, std::function< void(const uint64_t) > fn)
+{
+	run(name, size, max_ops, nullptr, fn);
+	return;
+}
+
+/* a "BENCH=" prefixed printable payload of the requested total size */
+static std::vector< uint8_t >
+make_payload(const std::size_t size)
+{
+	static const char		prefix[] = "BENCH=";
+	std::vector< uint8_t >	payload(std::max(size, sizeof(prefix)));
+
+	std::memcpy(payload.data(), prefix, sizeof(prefix) - 1);
+
+	for (std::size_t idx = sizeof(prefix) - 1; idx < payload.size(); idx++)
+		payload[idx] = 'a' + (idx * 7) % 26;
+
+	return payload;
+}
+
+/* an in-memory DATA object holding the payload, laid out as in a journal file */
+static std::vector< uint64_t >
+make_data_object(const std::vector< uint8_t >& payload)
+{
+	const std::size_t		osize(offsetof(data_object_t, payload) + payload.size());
+	std::vector< uint64_t >	buf(DIV_ROUND_UP(osize, sizeof(uint64_t)), 0);
+	object_t*				obj(reinterpret_cast< object_t* >(buf.data()));
+
+	obj->object.type 	= object_type_t::OBJECT_DATA;
+	obj->object.size 	= get_uint64(osize);
+	obj->data.hash 		= get_uint64(jenkins_hash64_t::hash(payload.data(), payload.size()));
+
+	std::memcpy(&obj->data.payload[0], payload.data(), payload.size());
+	return buf;
+}
+
+/*
+ * Writes a journal of cnt entries to a fresh temporary file and returns its
+ * name; every entry references a distinct payload derived from the given one
+ * and a payload shared by all of them. The value is varied in lowercase
+ * letters so that the payloads stay printable.
+ */
+static std::string
+make_journal(const std::vector< uint8_t >& payload, const uint64_t cnt)
+{
+	static const char			shared[] = "BENCH_ID=micro";
+	char						name[] = "/tmp/zapmicro.XXXXXX";
+	std::vector< uint8_t >		value(payload);
+	std::vector< hash_input_t >	in(2);
+	const uint128_vec_t			boot_id = {{ 1, 1 }};
+	output_journal_t			oj;
+	signed int					fd(::mkstemp(name));
+
+	if (0 > fd)
+		throw std::runtime_error("::make_journal(): error in mkstemp(3)");
+
+	/* output_file_t insists on creating the file itself */
+	(void)::close(fd);
+	(void)::unlink(name);
+
+	in[0].data = value.data();
+	in[0].size = value.size();
+	in[1].data = shared;
+	in[1].size = sizeof(shared) - 1;
+
+	oj.name(name);
+	oj.header_size(sizeof(header_contents_t));
+	oj.state(STATE_OFFLINE);
+	oj.size_hint(cnt * (offsetof(data_object_t, payload) + payload.size()));
+	oj.begin_write();
+
+	for (uint64_t idx = 0; idx < cnt; idx++) {
+		uint64_t val(idx);
+
+		/* three letters tell up to 17576 entries apart */
+		for (std::size_t pos = 6; pos < std::min< std::size_t >(value.size(), 9); pos++, val /= 26)
+			value[pos] = 'a' + val % 26;
+
+		oj.write_entry(1000000 + idx, 1000000 + idx, boot_id, in.data(), in.size());
+	}
+
+	oj.boot_id(boot_id);
+	oj.end_write();
+	return name;
+}
+
+static void
+bench_size(const std::size_t size)
+{
+	const std::vector< uint8_t >	payload(make_payload(size));
+	const std::vector< uint64_t >	dobj(make_data_object(payload));
+	const sbarray_t					key = {{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f }};
+	const siphash_key_t				skey(siphash24_key(key));
+	const uint64_t					unbounded(std::numeric_limits< uint64_t >::max());
+	std::vector< hash_input_t >		in(8);
+	std::vector< uint64_t >			out(8);
+	std::vector< uint64_t >			buf(dobj);
+	micro_output_journal_t*			oj(nullptr);
+	const uint64_t					n_entries(std::min< uint64_t >(4096, std::max< uint64_t >(64, (16 * 1024 * 1024) / payload.size())));
+	const std::string				jname(make_journal(payload, n_entries));
+	input_journal_t					ij;
+	std::vector< uint64_t >			offsets;
+	hash_filter_t					filter;
+
+	for (std::size_t idx = 0; idx < in.size(); idx++) {
+		in[idx].data = payload.data();
+		in[idx].size = payload.size();
+	}
+
+	run("jenkins", payload.size(), unbounded, [&](const uint64_t ops) {
+		for (uint64_t idx = 0; idx < ops; idx++)
+			sink = sink + jenkins_hash64_t::hash(payload.data(), payload.size());
+	});
+
+	run("jenkins_batch", payload.size(), unbounded, [&](const uint64_t ops) {
+		for (uint64_t idx = 0; idx < ops; idx += in.size()) {
+			const std::size_t cnt(std::min< uint64_t >(in.size(), ops - idx));
+
+			batch_hash_t::jenkins(in.data(), cnt, out.data());
+			sink = sink + out[0];
+		}
+	});
+
+	run("siphash_t", payload.size(), unbounded, [&](const uint64_t ops) {
+		siphash_t sh;
+
+		for (uint64_t idx = 0; idx < ops; idx++)
+			sink = sink + sh.hash(payload.data(), payload.size(), key);
+	});
+
+	run("siphash24", payload.size(), unbounded, [&](const uint64_t ops) {
+		for (uint64_t idx = 0; idx < ops; idx++)
+			sink = sink + siphash24(payload.data(), payload.size(), skey);
+	});
+
+	run("siphash24_batch", payload.size(), unbounded, [&](const uint64_t ops) {
+		for (uint64_t idx = 0; idx < ops; idx += 4) {
+			const std::size_t cnt(std::min< uint64_t >(4, ops - idx));
+
+			batch_hash_t::siphash24(in.data(), cnt, skey, out.data());
+			sink = sink + out[0];
+		}
+	});
+
+	/*
+	 * Every op appends a distinct DATA object (and links it into the hash
+	 * table and its field's chain); bounded so the arena stays modest. The
+	 * journal is set up, sized for the run, and torn down outside the timed
+	 * part.
+	 */
+	run("append_data_new", payload.size(), std::max< uint64_t >(1, (256 * 1024 * 1024) / payload.size()), [&](const uint64_t ops) {
+		delete oj;
+		oj = new micro_output_journal_t();
+
+		oj->header_size(sizeof(header_contents_t));
+		oj->size_hint(ops * (offsetof(data_object_t, payload) + payload.size()));
+		oj->begin_write();
+	}, [&](const uint64_t ops) {
+		data_object_t* obj(reinterpret_cast< data_object_t* >(buf.data()));
+
+		for (uint64_t idx = 0; idx < ops; idx++) {
+			object_t*	ret(nullptr);
+			uint64_t	offset(0);
+
+			/* keep the "BENCH=" prefix intact and vary the value */
+			std::memcpy(&obj->payload[6], &idx, std::min< std::size_t >(sizeof(idx), payload.size() - 6));
+			obj->hash = get_uint64(idx);
+
+			oj->append_data(obj, &ret, &offset);
+			sink = sink + offset;
+		}
+	});
+
+	/* every op finds the already appended DATA object through the hash table */
+	run("append_data_dup", payload.size(), unbounded, [&](const uint64_t ops) {
+		object_t*	ret(nullptr);
+		uint64_t	offset(0);
+
+		delete oj;
+		oj = new micro_output_journal_t();
+
+		oj->header_size(sizeof(header_contents_t));
+		oj->begin_write();
+		oj->append_data(reinterpret_cast< const data_object_t* >(dobj.data()), &ret, &offset);
+	}, [&](const uint64_t ops) {
+		const data_object_t*	obj(reinterpret_cast< const data_object_t* >(dobj.data()));
+		object_t*				ret(nullptr);
+		uint64_t				offset(0);
+
+		for (uint64_t idx = 0; idx < ops; idx++) {
+			oj->append_data(obj, &ret, &offset);
+			sink = sink + offset;
+		}
+	});
+
+	delete oj;
+
+	/*
+	 * The read side runs against a journal written above. Opening it checks
+	 * the object offsets once; afterwards move_to_object() only checks an
+	 * object the first time it is visited unless the journal is strict, in
+	 * which case it is checked (and, at the structural level, verified)
+	 * on every visit as when a corrupt file is suspected.
+	 */
+	ij.verify_level(VERIFY_STRUCTURAL);
+	ij.open(jname.c_str());
+
+	for (uint64_t off = ij.header_size(); ; ) {
+		const object_t* obj(ij.object_at(OBJECT_UNUSED, off));
+
+		if (OBJECT_DATA == obj->object.type)
+			offsets.push_back(off);
+
+		if (off == ij.tail_object_offset())
+			break;
+
+		off += ALIGN64(get_uint64(obj->object.size));
+	}
+
+	/* as used by -V: a needle that is never found scans every DATA payload in the file */
+	run("field_value_scan", n_entries * payload.size(), unbounded, [&](const uint64_t ops) {
+		uint64_t hash(0);
+
+		for (uint64_t idx = 0; idx < ops; idx++)
+			sink = sink + ij.find_field_value_hash("#nomatch#", hash);
+	});
+
+	run("object_at", payload.size(), unbounded, [&](const uint64_t ops) {
+		for (uint64_t idx = 0; idx < ops; idx++)
+			sink = sink + ij.object_at(OBJECT_DATA, offsets[idx % offsets.size()])->object.size;
+	});
+
+	run("object_at_strict", payload.size(), unbounded, [&](const uint64_t ops) {
+		ij.strict(true);
+
+		for (uint64_t idx = 0; idx < ops; idx++)
+			sink = sink + ij.object_at(OBJECT_DATA, offsets[idx % offsets.size()])->object.size;
+
+		ij.strict(false);
+	});
+
+	/* an op is one entry, wrapping around to the head of the file */
+	run("cursor_next", payload.size(), unbounded, [&](const uint64_t ops) {
+		entry_cursor_t cursor(ij);
+
+		for (uint64_t idx = 0; idx < ops; idx++) {
+			if (false == cursor.next()) {
+				cursor.reset();
+				(void)cursor.next();
+			}
+
+			sink = sink + cursor.offset();
+		}
+	});
+
+	/* every entry is checked against a handful of hashes, none of which match */
+	for (uint64_t idx = 0; idx < 16; idx++)
+		filter.add(idx);
+
+	run("filter_match", payload.size(), unbounded, [&](const uint64_t ops) {
+		entry_cursor_t cursor(ij);
+
+		for (uint64_t idx = 0; idx < ops; idx++) {
+			if (false == cursor.next()) {
+				cursor.reset();
+				(void)cursor.next();
+			}
+
+			sink = sink + filter.match(cursor.object());
+		}
+	});
+
+	(void)::unlink(jname.c_str());
+	return;
+}
+
+signed int
+main(signed int ac, char** av)
+{
+	parse_arguments(ac, av);
+
+	if (true == micro_params.counters && false == micro_perf.open())
+		ERROR("Performance counters are unavailable (perf_event_open failed)");
+
+	try {
+		std::ostringstream line;
+
+		line << std::left << std::setw(18) << "benchmark" << std::right << std::setw(8) << "bytes"
+			 << std::setw(20) << "time" << std::setw(17) << "throughput";
+
+		INFO(line.str());
+
+		for (std::size_t idx = 0; idx < micro_params.sizes.size(); idx++)
+			bench_size(micro_params.sizes[idx]);
+
+	} catch (std::exception& e) {
+		ERROR(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
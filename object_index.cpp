@@ -0,0 +1,236 @@
+#include "object_index.hpp"
+
+object_index_t::object_index_t(void)
+	: m_map(nullptr), m_map_size(0)
+{
+	reset();
+	return;
+}
+
+object_index_t::~object_index_t(void)
+{
+	reset();
+	return;
+}
+
+void
+object_index_t::reset(void)
+{
+	if (nullptr != m_map)
+		input_file_t::unmap(m_map, m_map_size);
+
+	m_map 		= nullptr;
+	m_map_size	= 0;
+
+	for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++) {
+		m_offsets[idx].clear();
+		m_ptr[idx] 		= nullptr;
+		m_count[idx]	= 0;
+	}
+
+	return;
+}
+
+void
+object_index_t::add(const index_type_t type, const uint64_t offset)
+{
+	if (INDEX_TYPE_MAX <= type)
+		throw journal_parameter_error_t("object_index_t::add(): invalid index type");
+	if (nullptr != m_map)
+		throw journal_invalid_logic_error_t("object_index_t::add(): attempt to modify mapped index");
+
+	m_offsets[type].push_back(offset);
+	return;
+}
+
+void
+object_index_t::finish(void)
+{
+	if (nullptr != m_map)
+		return;
+
+	for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++) {
+		m_ptr[idx]		= m_offsets[idx].data();
+		m_count[idx]	= m_offsets[idx].size();
+	}
+
+	return;
+}
+
+const bool
+object_index_t::mapped(void) const
+{
+	return nullptr != m_map;
+}
+
+const uint64_t*
+object_index_t::offsets(const index_type_t type) const
+{
+	if (INDEX_TYPE_MAX <= type)
+		throw journal_parameter_error_t("object_index_t::offsets(): invalid index type");
+
+	return m_ptr[type];
+}
+
+const uint64_t
+object_index_t::count(const index_type_t type) const
+{
+	if (INDEX_TYPE_MAX <= type)
+		throw journal_parameter_error_t("object_index_t::count(): invalid index type");
+
+	return m_count[type];
+}
+
+bool
+object_index_t::load(const std::string& name, const uint128_vec_t& file_id, const uint64_t tail, const uint64_t level)
+{
+	input_file_t					inf;
+	const object_index_header_t*	hdr(nullptr);
+	std::size_t						siz(0), need(sizeof(object_index_header_t));
+	const uint64_t*					ptr(nullptr);
+
+	reset();
+
+	if (0 != ::access(name.c_str(), R_OK))
+		return false;
+
+	inf.open(name.c_str());
+	siz = inf.size();
+
+	if (sizeof(object_index_header_t) > siz) {
+		DEBUG("object_index_t::load(): truncated index file: ", name);
+		return false;
+	}
+
+	m_map 		= inf.map(siz);
+	m_map_size	= siz;
+	inf.close();
+
+	hdr = reinterpret_cast< const object_index_header_t* >(m_map);
+
+	if (0 != std::memcmp(&hdr->signature[0], OBJECT_INDEX_SIGNATURE, sizeof(hdr->signature)) ||
+		get_uint64(hdr->file_id[0]) != file_id[0] || get_uint64(hdr->file_id[1]) != file_id[1] ||
+		get_uint64(hdr->tail_object_offset) != tail) {
+		DEBUG("object_index_t::load(): stale or foreign index file: ", name);
+		reset();
+		return false;
+	}
+
+	if (get_uint64(hdr->verify_level) < level) {
+		DEBUG("object_index_t::load(): index file built at a weaker verification level: ", name);
+		reset();
+		return false;
+	}
+
+	for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++) {
+		const uint64_t cnt(get_uint64(hdr->n_items[idx]));
+
+		if (cnt > (siz - need) / sizeof(uint64_t)) {
+			DEBUG("object_index_t::load(): index file item count exceeds file size: ", name);
+			reset();
+			return false;
+		}
+
+		need += cnt * sizeof(uint64_t);
+	}
+
+	if (need != siz) {
+		DEBUG("object_index_t::load(): index file size mismatch: ", name);
+		reset();
+		return false;
+	}
+
+	/*
+	 * Offsets are consumed straight out of the mapping, which requires the
+	 * host order to match the little endian order they are stored in; big
+	 * endian hosts simply fall back to rescanning.
+	 */
+#if defined(__BYTE_ORDER__)&&(__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	reset();
+	return false;
+#endif
+
+	ptr = reinterpret_cast< const uint64_t* >(m_map + sizeof(object_index_header_t));
+
+	for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++) {
+		m_ptr[idx] 		= ptr;
+		m_count[idx]	= get_uint64(hdr->n_items[idx]);
+		ptr 			+= m_count[idx];
+	}
+
+	/*
+	 * Callers binary search the offsets and dereference them, so each type
+	 * must be in strictly ascending file order, 64-bit aligned and within
+	 * the objects the file had when the index was written.
+	 */
+	for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++) {
+		uint64_t last(0);
+
+		for (uint64_t cnt = 0; cnt < m_count[idx]; cnt++) {
+			const uint64_t off(get_uint64(m_ptr[idx][cnt]));
+
+			if (off <= last || ! VALID64(off) || off > tail) {
+				DEBUG("object_index_t::load(): unordered or out of range offset in index file: ", name);
+				reset();
+				return false;
+			}
+
+			last = off;
+		}
+	}
+
+	return true;
+}
+
+bool
+object_index_t::save(const std::string& name, const uint128_vec_t& file_id, const uint64_t tail, const uint64_t level) const
+{
+	const std::string		tmp(name + ".tmp");
+	object_index_header_t	hdr;
+
+	std::memset(&hdr, 0, sizeof(object_index_header_t));
+	std::memcpy(&hdr.signature[0], OBJECT_INDEX_SIGNATURE, sizeof(hdr.signature));
+
+	hdr.file_id[0]			= get_uint64(file_id[0]);
+	hdr.file_id[1]			= get_uint64(file_id[1]);
+	hdr.tail_object_offset	= get_uint64(tail);
+	hdr.verify_level		= get_uint64(level);
+
+	for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++)
+		hdr.n_items[idx] = get_uint64(m_count[idx]);
+
+	/*
+	 * Written to a temporary and renamed into place so a concurrent or
+	 * interrupted run never observes a partially written index.
+	 */
+	try {
+		output_file_t ofile;
+
+		(void)::unlink(tmp.c_str());
+		ofile.open(tmp.c_str());
+		ofile.write(reinterpret_cast< const uint8_t* >(&hdr), sizeof(object_index_header_t));
+
+		for (std::size_t idx = 0; idx < INDEX_TYPE_MAX; idx++) {
+			std::vector< uint64_t > le(m_ptr[idx], m_ptr[idx] + m_count[idx]);
+
+			for (std::size_t cnt = 0; cnt < le.size(); cnt++)
+				le[cnt] = get_uint64(le[cnt]);
+
+			if (0 != le.size())
+				ofile.write(reinterpret_cast< const uint8_t* >(le.data()), le.size() * sizeof(uint64_t));
+		}
+
+		ofile.close();
+	} catch (std::exception& e) {
+		DEBUG("object_index_t::save(): error writing index file: ", e.what());
+		(void)::unlink(tmp.c_str());
+		return false;
+	}
+
+	if (0 != ::rename(tmp.c_str(), name.c_str())) {
+		(void)::unlink(tmp.c_str());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <vector>
+#include <array>
+#include <stdio.h>
+
+#include "global.hpp"
+#include "file.hpp"
+#include "exception.hpp"
+#include "object.hpp"
+#include "endian.hpp"
+#include "intstring.hpp"
+#include "log.hpp"
+
+#define OBJECT_INDEX_SIGNATURE 	"ZAPOIDX2"
+#define OBJECT_INDEX_SUFFIX 	".zapidx"
+
+typedef enum
+{
+	INDEX_DATA = 0,
+	INDEX_FIELD,
+	INDEX_ENTRY,
+	INDEX_TAG,
+	INDEX_TYPE_MAX
+} index_type_t;
+
+/*
+ * On-disk layout of the sidecar: this header followed by INDEX_TYPE_MAX
+ * arrays of little endian object offsets, one per type, in file order.
+ * file_id and tail_object_offset identify the journal the offsets belong
+ * to; any change to either invalidates the sidecar. verify_level is the
+ * input_journal_t verification level of the walk that found the offsets,
+ * which a sidecar stands in for and so must be at least as strict as the
+ * walk it replaces.
+ */
+typedef struct {
+	uint8_t		signature[8];
+	uint64_t	file_id[2];
+	uint64_t	tail_object_offset;
+	uint64_t	verify_level;
+	uint64_t	n_items[INDEX_TYPE_MAX];
+} object_index_header_t;
+
+/*
+ * Offsets of every DATA/FIELD/ENTRY/TAG object in a journal, either built
+ * by a walk over the objects or mapped from a previously saved sidecar.
+ */
+class object_index_t
+{
+	private:
+		object_index_t(const object_index_t&)				= delete;
+		object_index_t& operator=(const object_index_t&)	= delete;
+
+	protected:
+		std::array< std::vector< uint64_t >, INDEX_TYPE_MAX >	m_offsets;
+		std::array< const uint64_t*, INDEX_TYPE_MAX >			m_ptr;
+		std::array< uint64_t, INDEX_TYPE_MAX >					m_count;
+		uint8_t*												m_map;
+		std::size_t												m_map_size;
+
+	public:
+		object_index_t(void);
+		virtual ~object_index_t(void);
+
+		virtual void reset(void);
+
+		virtual void add(const index_type_t, const uint64_t);
+		virtual void finish(void);
+
+		virtual const bool mapped(void) const;
+		virtual const uint64_t* offsets(const index_type_t) const;
+		virtual const uint64_t count(const index_type_t) const;
+
+		virtual bool load(const std::string&, const uint128_vec_t&, const uint64_t, const uint64_t);
+		virtual bool save(const std::string&, const uint128_vec_t&, const uint64_t, const uint64_t) const;
+};
@@ -1,19 +1,13 @@
 #include "output_journal.hpp"
 
 output_journal_t::output_journal_t(void)
-	: journal_base_t(), m_data_hash_table(nullptr), m_field_hash_table(nullptr)
+	: journal_base_t(), m_data_hash_table(nullptr), m_field_hash_table(nullptr), m_size_hint(0)
 {
 	return;
 }
 
 output_journal_t::output_journal_t(const char* name)
-	: journal_base_t(name), m_data_hash_table(nullptr), m_field_hash_table(nullptr)
-{
-	return;
-}
-
-output_journal_t::output_journal_t(const journal_base_t& journal)
-	: journal_base_t(journal), m_data_hash_table(nullptr), m_field_hash_table(nullptr)
+	: journal_base_t(name), m_data_hash_table(nullptr), m_field_hash_table(nullptr), m_size_hint(0)
 {
 	return;
 }
@@ -24,113 +18,6 @@ output_journal_t::~output_journal_t(void)
 	return;
 }
 
-bool
-output_journal_t::has_data_object(const data_obj_t& obj) const
-{
-	const std::size_t mdval(m_data_objects.size());
-
-	for (std::size_t idx = 0; idx < mdval; idx++) {
-		if (obj.hash() == m_data_objects[idx].hash()) {
-				const std::string& left(obj.to_string()), right(m_data_objects[idx].to_string());
-				const std::size_t  len(left.length());
-
-				if (len == right.length() && 0 == ::strncasecmp(left.c_str(), right.c_str(), len))
-					return true;
-		}
-	}
-
-	return false;
-}
-
-bool
-output_journal_t::has_field_object(const field_obj_t& obj) const
-{
-	const std::size_t mfval(m_field_objects.size());
-
-	for (std::size_t idx = 0; idx < mfval; idx++) {
-		if (obj.hash() == m_field_objects[idx].hash()) {
-			const std::string left(obj.to_string()), right(m_field_objects[idx].to_string());
-			const std::size_t len(left.length());
-
-			if (len == right.length() && 0 == ::strncasecmp(left.c_str(), right.c_str(), len))
-				return true;
-		}
-	}
-
-	return false;
-}
-
-bool 
-output_journal_t::split_field_value(const std::string& src, std::string& dst) const
-{
-	std::string sval(src);
-	std::size_t pos(0);
-	field_obj_t obj(0,0,0);
-
-	/* 
-	 * What should be a simple string splitting routine isn't more or less for the same
-     * reason as the comment in find_field_value(). A Python script was found to be 
-     * appending binary gibberish before the actual values. The methodology in 
-     * find_field_value() almost fixed everything, except the ASCII character 
-     * following the gibberish in one entry happened to be "=" which broke
-     * this. So, now I have to redundantly check to make sure we have a 
-     * matching entry (which we always should).
-     */
-
-	do {
-		pos = sval.find("=");
-		
-		if (std::string::npos == pos) 
-			return false;
-
-		dst = src.substr(0,pos);
-		if (true == find_field_value(dst, obj)) 
-			return true;
-
-		sval = sval.substr(1);
-	} while (0 != sval.length());
-
-	return false;
-}
-
-bool 
-output_journal_t::find_field_value(const std::string& key, field_obj_t& dst) const
-{
-	std::string		  	kval(key);
-	const std::size_t 	fvmax(m_field_objects.size());
-	std::size_t 		len(key.length());
-
-	if (0 == len)
-		return false;
-
-	do {
-		for (std::size_t idx = 0; idx < fvmax; idx++) {
-			const std::string field(m_field_objects[idx].to_string());
-
-			if (len == field.length() && 0 == kval.compare(field)) {
-				dst = m_field_objects[idx];
-				return true;
-			}
-		}
-
-		/* 
-		 * This is requisite because for whatever reason some log entries I encountered
-		 * had a more or less invalid field, namely non-printable characters preceeding
-		 * the actual field value. journalctl seems to ignore it but I verified repeatedly
-		 * that the value is definitely in the raw log file. So this is a hackish work
-		 * around because the entry in question was basically:
-		 * "<nonprintable gibberish>(MESSAGE=" with the field obviously being MESSAGE.
-		 * 
-		 * FTR, it was a python script generating the message.
-		 */
-		kval 	= kval.substr(1);
-		len		= kval.length();
-
-	} while (0 != kval.length());
-
-	return false;
-}
-
 bool
 output_journal_t::allocate(const uint64_t offset, const uint64_t size)
 {
@@ -155,6 +42,13 @@ output_journal_t::allocate(const uint64_t offset, const uint64_t size)
 	if (new_size <= old_size)
 		return true;
 
+	/*
+	 * Every growth copies the arena, so grow at least geometrically to keep
+	 * writing large journals linear rather than quadratic in their size.
+	 */
+	if (old_size > new_size / 2)
+		new_size = std::min< uint64_t >(old_size * 2, PAGE_ALIGN_DOWN(std::numeric_limits< uint64_t >::max()) - FILE_SIZE_INCREASE);
+
 	new_size = DIV_ROUND_UP(new_size, FILE_SIZE_INCREASE) * FILE_SIZE_INCREASE;
 
 	DEBUG("Allocating ", new_size, " bytes after rounding");
@@ -183,7 +77,7 @@ output_journal_t::append_object(const object_type_t& type, const uint64_t size,
 	object_t*	o(nullptr);
 	void*		t(nullptr);
 
-	DEBUG("Appending object of type: ", obj_hdr_t::type_string(type), " and size: ", to_dec_string(size));
+	DEBUG("Appending object of type: ", object_type_string(type), " and size: ", to_dec_string(size));
 
 	if (nullptr == m_ptr)
 		throw journal_parameter_error_t("output_journal_t::append_object(): invalid object state (m_ptr == nullptr)");
@@ -223,7 +117,7 @@ output_journal_t::append_object(const object_type_t& type, const uint64_t size,
 	m_tail_object_offset 	= p;
 	m_n_objects 			+= 1;	
 
-	DEBUG("Appended object of type: ", obj_hdr_t::type_string(type),
+	DEBUG("Appended object of type: ", object_type_string(type),
 			" flags: ", to_dec_string(o->object.flags),
 			" size: ", to_dec_string(o->object.size),
 			" at offset: ", to_dec_string(p));
@@ -273,7 +167,7 @@ output_journal_t::append_field(const field_object_t* object, const void* data, c
 	
 	DEBUG("Creating new field object");
 
-	osize = offsetof(field_object_t, payload) + get_uint64(object->object.size);
+	osize = get_uint64(object->object.size);
 	append_object(object_type_t::OBJECT_FIELD, osize, &obj, &p);
 
 	obj->object.type 			= object->object.type;
@@ -301,9 +195,12 @@ output_journal_t::append_field(const field_object_t* object, const void* data, c
 void
 output_journal_t::append_data(const data_object_t* object, object_t** ret, uint64_t* ret_offset)
 {
-	uint64_t 	hash(0), p(0), osize(0);
-	object_t*	obj(nullptr);
-	signed int	retval(0);
+	uint64_t 		hash(0), p(0), osize(0), len(0), offset(0);
+	object_t*		obj(nullptr);
+	object_t*		field(nullptr);
+	const uint8_t*	eq(nullptr);
+	field_object_t	fobj({0});
+	signed int		retval(0);
 
 	if (nullptr == object)
 		throw journal_parameter_error_t("output_journal_t::append_data(): invalid parameters (nullptr == object)");
@@ -337,7 +234,7 @@ output_journal_t::append_data(const data_object_t* object, object_t** ret, uint6
 		return;
 	}
 
-	osize = offsetof(data_object_t, payload) + get_uint64(object->object.size);
+	osize = get_uint64(object->object.size);
 	append_object(object_type_t::OBJECT_DATA, osize, &obj, &p);
 	// if (JOURNAL_FILE_COMPRESS(f) && size >= f->compress_threshold_bytes) {
 
@@ -358,40 +255,27 @@ output_journal_t::append_data(const data_object_t* object, object_t** ret, uint6
 	link_data(obj, p, hash);
 	move_to_object(object_type_t::OBJECT_DATA, p, &obj);
 
-	{
-		std::string 	key("");
-		std::string		full_value(reinterpret_cast< const char* >(&object->payload[0]), get_uint64(object->object.size) - offsetof(data_object_t, payload));
-		field_obj_t 	field_obj(0,0,0);
-		field_object_t	fobj({0});
-		object_t*		object(nullptr);
-		uint64_t		offset(0);
+	/*
+	 * The field name is taken the way journald does it: everything up to
+	 * the first '='.
+	 */
+	len	= get_uint64(object->object.size) - offsetof(data_object_t, payload);
+	eq	= static_cast< const uint8_t* >(std::memchr(&object->payload[0], '=', len));
 
-		std::memset(&fobj, 0, sizeof(field_object_t));
+	if (nullptr == eq || eq == &object->payload[0])
+		throw journal_invalid_logic_error_t("output_journal_t::append_data(): error locating field name in data object");
 
-		if (false == split_field_value(full_value, key))
-			throw journal_invalid_logic_error_t("output_journal_t::append_data(): error locating field value in data object");
-		if (false == find_field_value(key, field_obj))
-			throw journal_invalid_logic_error_t("output_journal_t::append_data(): error retrieving field object");
-		
-		DEBUG("Found existing field object in vector: type: ", to_dec_string(field_obj.type()),
-				" flags: ", to_dec_string(field_obj.flags()),
-				" size: ", to_dec_string(field_obj.object_size()),
-				" hash: ", to_dec_string(field_obj.hash()));
-
-		fobj.object.type 		= field_obj.type();
-		fobj.object.flags		= get_uint64(field_obj.flags());
-		fobj.object.size 		= get_uint64(field_obj.object_size());
-		fobj.hash				= get_uint64(field_obj.hash());
-		
-		fobj.next_hash_offset	= 0;
-		fobj.next_hash_offset	= 0;
-		fobj.head_data_offset	= 0;
+	std::memset(&fobj, 0, sizeof(field_object_t));
 
-		append_field(&fobj, field_obj.payload().data(), field_obj.payload().size(), &object, &offset);
+	fobj.object.type 		= object_type_t::OBJECT_FIELD;
+	fobj.object.size 		= get_uint64(offsetof(field_object_t, payload) + (eq - &object->payload[0]));
+	fobj.hash				= get_uint64(hash_data(&object->payload[0], eq - &object->payload[0]));
 
-		obj->data.next_field_offset 	= object->field.head_data_offset;
-		object->field.head_data_offset 	= get_uint64(p);	
-	}
+	append_field(&fobj, &object->payload[0], eq - &object->payload[0], &field, &offset);
+	move_to_object(object_type_t::OBJECT_DATA, p, &obj);
+
+	obj->data.next_field_offset 	= field->field.head_data_offset;
+	field->field.head_data_offset 	= get_uint64(p);	
 
 	if (nullptr != ret)
 		*ret = obj;
@@ -437,6 +321,7 @@ output_journal_t::append_entry_internal(const entry_object_t* object, uint64_t*
 	
 	// r = journal_file_hmac_put_object(f, OBJECT_ENTRY, o, np);
 	link_entry(obj, np);
+	move_to_object(object_type_t::OBJECT_ENTRY, np, &obj);
 	
 	if (nullptr != ret)
 		*ret = obj;
@@ -446,93 +331,6 @@ output_journal_t::append_entry_internal(const entry_object_t* object, uint64_t*
 	return;
 }
 
-void 
-output_journal_t::append_entry(const entry_obj_t* object, uint64_t* seqnum, object_t** ret, uint64_t* ret_offset, bool p)
-{
-	std::size_t		n_items(0);
-	entry_item_t*	items(nullptr);
-	entry_object_t*	entry(nullptr);
-
-	if (nullptr == object)
-		throw journal_parameter_error_t("output_journal_t::append_entry(): invalid parameter encountered (nullptr)");
-
-	DEBUG("Appending entry of type: ", obj_hdr_t::type_string(object->type()),
-			" flags: ", to_dec_string(object->flags()),
-			" size: ", to_dec_string(object->object_size()),
-			" seqnum: ", to_dec_string(object->seqnum()),
-			" realtime: ", to_dec_string(object->realtime()),
-			" monotonic: ", to_dec_string(object->monotonic()),
-			" boot_id: ", to_hex_string(object->boot_id()[0]), to_hex_string(object->boot_id()[1]),
-			" xor_hash: ", to_dec_string(object->xor_hash()));
-
-	n_items = std::max(std::size_t(1ULL), object->items().size());
-
-	if (n_items > std::numeric_limits< std::size_t >::max() / sizeof(entry_item_t))
-		throw journal_overflow_error_t("output_journal_t::append_entry(): multiplicative overflow encountered in entry item array");
-
-	if (sizeof(entry_object_t) > std::numeric_limits< std::size_t >::max() - (n_items * sizeof(entry_item_t)))
-		throw journal_overflow_error_t("output_journal_t::append_entry(): additive overflow encountered in total object size");
-
-	entry = reinterpret_cast< entry_object_t* >(new uint8_t[sizeof(entry_object_t) + (n_items * sizeof(entry_item_t))]);
-	std::memset(entry, 0, sizeof(entry_object_t) + (n_items * sizeof(entry_item_t)));
-
-	entry->object.type	= object->type();
-	entry->object.flags	= object->flags();
-	entry->object.size	= object->object_size();	
-	entry->realtime 	= object->realtime();
-	entry->monotonic 	= object->monotonic();
-	entry->boot_id[0]	= object->boot_id()[0];
-	entry->boot_id[1]	= object->boot_id()[1];
-	entry->xor_hash		= object->xor_hash();
-	
-	if (! VALID_REALTIME(entry->realtime))
-		throw journal_invalid_logic_error_t("output_journal_t::append_entry(): invalid real-time timestamp in entry");
-	if (! VALID_MONOTONIC(entry->monotonic))
-		throw journal_invalid_logic_error_t("output_journal_t::append_entry(): invalid monotonic timestamp in entry");
-
-	items = reinterpret_cast< entry_item_t* >(&entry->items[0]);
-
-	for (std::size_t idx = 0; idx < n_items; idx++) {
-		uint64_t 		p(0);
-		object_t*		o(nullptr);
-		obj_hdr_t*		ohdr(object->items()[idx]);
-		data_obj_t*		data_object(dynamic_cast< data_obj_t* >(ohdr));
-		data_object_t*	dobj(nullptr);
-
-		if (nullptr == ohdr || nullptr == data_object)
-			throw journal_invalid_logic_error_t("output_journal_t::append_entry(): invalid item encountered in entry (nullptr)");
-		if (object_type_t::OBJECT_DATA != ohdr->type())
-			throw journal_invalid_logic_error_t("output_journal_t::append_entry(): invalid item type encountered in entry (!OBJECT_DATA)");
-
-		dobj = reinterpret_cast< data_object_t* >(new uint8_t[sizeof(data_object_t) + data_object->payload().size()]);
-
-		std::memset(dobj, 0, sizeof(data_object_t) + data_object->payload().size());
-		std::memcpy(&dobj->payload[0], data_object->payload().data(), data_object->payload().size());
-
-		dobj->object.type	= data_object->type();
-		dobj->object.flags	= data_object->flags();
-		dobj->object.size	= data_object->object_size(); 
-		dobj->hash 			= data_object->hash();
-		dobj->n_entries 	= data_object->n_entries();
-
-		append_data(dobj, &o, &p);		
-
-		items[idx].object_offset 	= get_uint64(p);
-		items[idx].hash 			= get_uint64(dobj->hash);
-
-		DEBUG("appended data object for item[", to_dec_string(idx), "] at object_offset: ", to_dec_string(p), " hash: ", to_hex_string(dobj->hash));
-
-		delete[] dobj;
-		//std::free(dobj);
-	}
-
-	// typesafe_qsort(items, n_iovec, entry_item_cmp);
-
-	append_entry_internal(entry, seqnum, ret, ret_offset);
-	delete[] entry;
-	return;
-}
-
 void 
 output_journal_t::link_data(object_t* object, const uint64_t offset, const uint64_t hash)
 {
@@ -617,6 +415,8 @@ output_journal_t::link_entry_into_array(uint64_t* first, uint64_t* idx, const ui
 {
 	uint64_t    n(0), ap(0), q(0), i(0), a(0), hidx(0);
 	object_t*   object(nullptr);
+	
+	std::unordered_map< uint64_t, std::pair< uint64_t, uint64_t > >::const_iterator tail;
 
 	if (nullptr == first || nullptr == idx)
 		throw journal_parameter_error_t("output_journal_t::link_entry_into_array(): invalid parameter(s) (nullptr)");
@@ -625,6 +425,18 @@ output_journal_t::link_entry_into_array(uint64_t* first, uint64_t* idx, const ui
 	i       = get_uint64(*idx);
 	hidx    = i;
 
+	/*
+	 * Items only ever go into the last array of a chain, so rather than
+	 * walking the whole chain (a cache miss per array once the file is
+	 * large) the walk starts at the remembered tail.
+	 */
+	tail = m_entry_array_tails.find(a);
+
+	if (0 != a && tail != m_entry_array_tails.end() && i >= tail->second.second) {
+		a 	= tail->second.first;
+		i 	-= tail->second.second;
+	}
+
 	DEBUG("link_entry_into_array(0): first: ", to_dec_string(*first), " idx: ", to_dec_string(*idx));
 
 	while (0 < a) {
@@ -669,6 +481,8 @@ output_journal_t::link_entry_into_array(uint64_t* first, uint64_t* idx, const ui
 		object->entry_array.next_entry_array_offset = get_uint64(q);
 	}
 
+	m_entry_array_tails[get_uint64(*first)] = std::make_pair(q, hidx - i);
+
 	// if (JOURNAL_HEADER_CONTAINS(f->header, n_entry_arrays))
 	m_n_entry_arrays    += 1;
 	*idx                = get_uint64(hidx + 1);
@@ -677,67 +491,6 @@ output_journal_t::link_entry_into_array(uint64_t* first, uint64_t* idx, const ui
 }
 
 
-void 
-output_journal_t::link_entry_into_array(data_object_t* obj, uint64_t* idx, const uint64_t p) 
-{
-	uint64_t 	n(0), ap(0), q(0), i(0), a(0), hidx(0);
-	object_t*	object(nullptr);
-
-	if (nullptr == object || nullptr == idx) 
-		throw journal_parameter_error_t("output_journal_t::link_entry_into_array(): invalid parameter(s) (nullptr)");
-
-	a 		= get_uint64(obj->entry_array_offset); 
-	i 		= get_uint64(*idx);
-	hidx 	= i;
-
-	while (0 < a) {
-		move_to_object(object_type_t::OBJECT_ENTRY_ARRAY, a, &object);
-
-		n = file_entry_array_n_items(object);
-		
-		if (i < n) {
-			object->entry_array.items[i] = get_uint64(p);
-			*idx = get_uint64(hidx + 1);
-
-			DEBUG("Linking entry into array as item number: ", i, " at offset: ", p);
-			return;
-		}
-
-		i 	-= n;
-		ap 	= a;
-		a 	= get_uint64(object->entry_array.next_entry_array_offset);
-	}
-
-	if (hidx > n)
-		n = (hidx + 1) * 2;
-	else
-		n *= 2;
-
-	if (4 > n)
-		n = 4;
-
-	append_object(object_type_t::OBJECT_ENTRY_ARRAY, offsetof(object_t, entry_array.items) + n * sizeof(uint64_t), &object, &q);
-	
-	// journal_file_hmac_put_object(f, OBJECT_ENTRY_ARRAY, o, q);
-
-	object->entry_array.items[i] = get_uint64(p);
-	DEBUG("Linked entry into array as item number: ", i, " at offset: ", p);
-	
-	if (0 == ap)
-		obj->entry_array_offset = get_uint64(q);
-	else {
-		move_to_object(object_type_t::OBJECT_ENTRY_ARRAY, ap, &object);
-
-		object->entry_array.next_entry_array_offset = get_uint64(q);
-	}
-	
-	// if (JOURNAL_HEADER_CONTAINS(f->header, n_entry_arrays))
-	m_n_entry_arrays 	+= 1;
-	*idx 				= get_uint64(hidx + 1);
-	DEBUG("Number of entry arrays: ", m_n_entry_arrays);
-	return;
-}
-
 void 
 output_journal_t::link_entry_item(object_t* object, const entry_item_t* item, const uint64_t offset)
 {
@@ -747,33 +500,40 @@ output_journal_t::link_entry_item(object_t* object, const entry_item_t* item, co
 		throw journal_parameter_error_t("output_journal_t::link_entry_item(): invalid parameter encountered");
 
 	p = get_uint64(item->object_offset);
-	move_to_object(object_type_t::OBJECT_DATA, p, &object);
 
-	link_entry_into_array_plus_one(&object->data, offset); 
+	link_entry_into_array_plus_one(p, offset); 
 	return;
 }
 
 void
-output_journal_t::link_entry_into_array_plus_one(data_object_t* object, const uint64_t p)
+output_journal_t::link_entry_into_array_plus_one(const uint64_t offset, const uint64_t p)
 {
-	uint64_t hidx(0);
+	uint64_t 	hidx(0);
+	object_t*	object(nullptr);
 
-	if (nullptr == object || 0 >= p)
+	if (0 >= offset || 0 >= p)
 		throw journal_parameter_error_t("output_journal_t::link_entry_into_array_plus_one(): invalid parameter(s) encountered");
 
-	hidx = get_uint64(object->n_entries);
+	move_to_object(object_type_t::OBJECT_DATA, offset, &object);
+	hidx = get_uint64(object->data.n_entries);
 
 	if (hidx == std::numeric_limits< uint64_t >::max())
 		throw journal_invalid_logic_error_t("output_journal_t::link_entry_into_array_plus_one(): invalid index encountered (UINT64_MAX)");
 
 	if (0 == hidx)
-		object->entry_offset = get_uint64(p);
+		object->data.entry_offset = get_uint64(p);
 	else {
+		uint64_t first(get_uint64(object->data.entry_array_offset));
 		uint64_t i(get_uint64(hidx - 1));
-		link_entry_into_array(object, &i, p);
+
+		/* appending an entry array may move the arena, so the object is looked up again */
+		link_entry_into_array(&first, &i, p);
+		move_to_object(object_type_t::OBJECT_DATA, offset, &object);
+
+		object->data.entry_array_offset = get_uint64(first);
 	}
 
-	object->n_entries = get_uint64(hidx + 1);
+	object->data.n_entries = get_uint64(hidx + 1);
 	return;
 }
 
@@ -814,6 +574,9 @@ output_journal_t::link_entry(object_t* object, const uint64_t offset)
 
 	link_entry_into_array(&m_entry_array_offset, &m_n_entries, offset);
 
+	/* appending an entry array may have grown, and thus moved, the arena */
+	move_to_object(object_type_t::OBJECT_ENTRY, offset, &object);
+
 	if (0 == m_head_entry_realtime)
 		m_head_entry_realtime = object->entry.realtime;
 
@@ -825,6 +588,7 @@ output_journal_t::link_entry(object_t* object, const uint64_t offset)
 	for (uint64_t idx = 0; idx < n_items; idx++) { 
 		DEBUG("Linking entry item #", to_dec_string(idx), " object_offset: ", to_dec_string(object->entry.items[idx].object_offset), " hash: ", to_hex_string(object->entry.items[idx].hash));
 		link_entry_item(object, &object->entry.items[idx], offset);
+		move_to_object(object_type_t::OBJECT_ENTRY, offset, &object);
 	}
 
 	return;	
@@ -929,7 +693,7 @@ output_journal_t::find_field_object_with_hash(const field_object_t* object, cons
 		return false;
 
 	hash 		= get_uint64(object->hash);
-	osize 		= offsetof(object_t, field.payload) + get_uint64(object->object.size);
+	osize 		= get_uint64(object->object.size);
 	hash_idx 	= hash % fht_size;
 
 	p = m_field_hash_table[hash_idx].head_hash_offset;
@@ -980,6 +744,14 @@ output_journal_t::setup_data_hash_table(void)
 	uint64_t 	s(DEFAULT_DATA_HASH_TABLE_SIZE), p(0);
 	object_t*	o(nullptr);
 
+	/*
+	 * Sized the way journald does it: assume an average object size of 768
+	 * bytes and a hash table fill level of 75%, so long chains are not walked
+	 * for every DATA object appended to a large file.
+	 */
+	if (m_size_hint / 768 * 4 / 3 > DEFAULT_DATA_HASH_TABLE_SIZE / sizeof(hash_item_t))
+		s = (m_size_hint / 768 * 4 / 3) * sizeof(hash_item_t);
+
 	append_object(object_type_t::OBJECT_DATA_HASH_TABLE, offsetof(object_t, hash_table.items) + s, &o, &p);
 	std::memset(o->hash_table.items, 0, s);
 
@@ -1006,12 +778,9 @@ output_journal_t::find_data_object_with_hash(const data_object_t* object, object
 		return false;
 
 	hash		= get_uint64(object->hash);
-	osize 		= offsetof(object_t, object.payload) + get_uint64(object->object.size);
+	osize 		= get_uint64(object->object.size);
 	hash_idx	= hash % dht_size;
 
-	if (0 == hash_idx)
-		return false;
-
 	p = m_data_hash_table[hash_idx].head_hash_offset;
 
 	while (0 < p) {
@@ -1023,7 +792,7 @@ output_journal_t::find_data_object_with_hash(const data_object_t* object, object
 			// if (o->object.flags & OBJECT_COMPRESSION_MASK) { }
 
 			if (get_uint64(obj->object.size) == osize && 
-				0 == std::memcmp(&obj->data.payload[0], &object->payload[0], offsetof(data_object_t, payload) - get_uint64(object->object.size))) 
+				0 == std::memcmp(&obj->data.payload[0], &object->payload[0], osize - offsetof(data_object_t, payload))) 
 			{
 				if (nullptr != ret)
 					*ret = obj;
@@ -1063,6 +832,8 @@ output_journal_t::write_payload(const void* data, const std::size_t len, const u
 void
 output_journal_t::write_header(void)
 {
+	TRACE_SCOPE("output_journal_t::write_header");
+
 	header_contents_t* 	hdr(reinterpret_cast< header_contents_t* >(m_ptr));
 	const char*			magic("LPKSHHRH");
 
@@ -1108,119 +879,20 @@ output_journal_t::write_header(void)
 	return;	
 }
 
-void 
-output_journal_t::update(std::list< entry_obj_t >& entries)
-{
-
-	if (true == entries.empty())
-		return; 
-
-	m_data_objects.clear();
-	m_entry_objects.clear();
-
-	entries.sort();
-
-	for (std::list< entry_obj_t >::iterator itr = entries.begin(); itr != entries.end(); itr++) {
-		const std::vector< obj_hdr_t* >& 	items(itr->items());
-		const std::size_t					mival(items.size()); 
-
-		for (std::size_t eidx = 0; eidx < mival; eidx++) {
-			obj_hdr_t* obj(items[eidx]);
-
-			if (nullptr == obj)
-				throw journal_invalid_logic_error_t("output_journal_t::update(): invalid entry item encountered (nullptr)");
-
-			switch (obj->type()) {
-				case object_type_t::OBJECT_DATA:
-				{
-					data_obj_t* dobj = dynamic_cast< data_obj_t* >(obj);
-	
-					if (nullptr == dobj)
-						throw dynamic_cast_failure_error_t("output_journal_t::update(): object of correct type failed dynamic_cast (data_obj_t)");
-								
-					if (false == has_data_object(*dobj))
-						m_data_objects.push_back(*dobj);
-
-				}
-				break;
-
-				default:
-					throw journal_invalid_logic_error_t("output_journal_t::update(): unknown/unsupported entry object item type encountered");
-				break;
-				
-			}
-		}
-
-		m_entry_objects.push_back(*itr);
-	}
-
-	{
-		const std::size_t 			dvmax(m_data_objects.size());
-		std::list< field_obj_t >	flist;
-
-		for (std::size_t idx = 0; idx < dvmax; idx++) {
-			std::string key("");
-			bool		found(false);
-			field_obj_t obj(0,0,0);
-
-			if (false == split_field_value(m_data_objects[idx].to_string(), key)) 
-				throw journal_invalid_logic_error_t("output_journal_t::update(): failure while splitting data value");
-
-			if (false == find_field_value(key, obj))
-				throw journal_invalid_logic_error_t("output_journal_t::update(): faild to find data object name in field object vector");
-
-			for (std::list< field_obj_t >::iterator itr = flist.begin(); itr != flist.end(); itr++) {
-				const std::string flist_field(itr->to_string());
-				const std::string fvec_field(obj.to_string());
-				const std::size_t len(fvec_field.length());
-
-				if (itr->hash() == obj.hash() && len == flist_field.length() && 0 == fvec_field.compare(flist_field)) {
-					found = true;
-					break;
-				}
-			}
-
-			if (false == found) 
-				flist.push_back(obj);
-		}
-
-		m_field_objects.clear();
-		m_field_objects.insert(m_field_objects.begin(), flist.begin(), flist.end());
-	}
-
-	m_data_hash_table_offset 	= 0;
-	m_data_hash_table_size 		= 0;
-	m_field_hash_table_offset 	= 0;
-	m_field_hash_table_size 	= 0;
-	m_tail_object_offset 		= 0;
-	m_n_objects 				= 0;
-	m_tail_entry_seqnum 		= 0;
-	m_head_entry_seqnum 		= 0;
-	m_entry_array_offset 		= 0;
-	m_head_entry_realtime 		= 0;
-	m_tail_entry_realtime 		= 0;
-	m_tail_entry_monotonic 		= 0;
-	m_data_hash_chain_depth 	= 0;
-	m_field_hash_chain_depth 	= 0;
-
-	m_n_tags	= m_tag_objects.size();
-	m_n_entries = m_entry_objects.size();
-	m_n_data	= m_data_objects.size();
-	m_n_fields 	= m_field_objects.size();
-
-	return;
-}
-
-bool
-output_journal_t::write(void)
+void
+output_journal_t::begin_write(void)
 {
-	const std::size_t 	emval(m_entry_objects.size());
-	output_file_t		ofile(m_name.c_str());
+	TRACE_SCOPE("output_journal_t::begin_write");
 
 	if (nullptr != m_ptr) 
 		dealloc();
 
+	m_data_hash_table			= nullptr;
+	m_field_hash_table			= nullptr;
 	m_arena_size				= 0;
+
+	m_entry_array_tails.clear();
+
 	m_data_hash_table_offset    = 0;
 	m_data_hash_table_size      = 0;
 	m_field_hash_table_offset   = 0;
@@ -1242,26 +914,189 @@ output_journal_t::write(void)
 	m_n_entry_arrays			= 0;
 
 	if (false == allocate(m_header_size, 1))
-		return false;
+		throw journal_allocation_error_t("output_journal_t::begin_write(): failure during allocation");
 
 	std::memset(m_ptr, 0, m_size);
 
 	// journal_file_hmac_setup
 
 	if (false == setup_field_hash_table() || false == setup_data_hash_table())
-		return false;
+		throw journal_allocation_error_t("output_journal_t::begin_write(): failure while creating hash tables");
 
 	// journal_file_append_first_tag
 
-	for (std::size_t idx = 0; idx < emval; idx++) {
-		entry_obj_t e(m_entry_objects[idx]);
-		append_entry(&e, nullptr, nullptr, nullptr);
+	return;
+}
+
+bool
+output_journal_t::write_entry(const journal_base_t& src, const object_t* entry, const std::vector< uint64_t >& drop)
+{
+	uint64_t					n_items(0), kept(0), xor_hash(0);
+	entry_object_t*				eobj(nullptr);
+	std::vector< hash_input_t >	payloads;
+
+	if (nullptr == entry || object_type_t::OBJECT_ENTRY != entry->object.type)
+		throw journal_parameter_error_t("output_journal_t::write_entry(): invalid parameter (nullptr or !OBJECT_ENTRY)");
+
+	n_items = file_entry_n_items(entry);
+	eobj 	= reinterpret_cast< entry_object_t* >(new uint8_t[sizeof(entry_object_t) + n_items * sizeof(entry_item_t)]);
+
+	std::memset(eobj, 0, sizeof(entry_object_t) + n_items * sizeof(entry_item_t));
+
+	/*
+	 * Items are resolved one at a time against the source journal and the
+	 * DATA object is appended straight from its on-disk representation, so
+	 * nothing beyond this entry is ever held in memory.
+	 */
+	for (uint64_t idx = 0; idx < n_items; idx++) {
+		const uint64_t	hash(get_uint64(entry->entry.items[idx].hash));
+		const object_t*	dobj(nullptr);
+		object_t*		o(nullptr);
+		uint64_t		p(0);
+
+		if (true == std::binary_search(drop.begin(), drop.end(), hash))
+			continue;
+
+		dobj = src.object_at(object_type_t::OBJECT_DATA, get_uint64(entry->entry.items[idx].object_offset));
+
+		append_data(&dobj->data, &o, &p);
+
+		if (JOURNAL_HEADER_KEYED_HASH(m_incompatible_flags)) {
+			const hash_input_t hin = { &dobj->data.payload[0], get_uint64(dobj->object.size) - offsetof(data_object_t, payload) };
+
+			payloads.push_back(hin);
+		} else
+			xor_hash ^= hash;
+
+		eobj->items[kept].object_offset	= get_uint64(p);
+		eobj->items[kept].hash			= dobj->data.hash;
+		kept++;
+	}
+
+	if (0 == kept) {
+		delete[] reinterpret_cast< uint8_t* >(eobj);
+		return false;
+	}
+
+	/*
+	 * On keyed files the xor hash is made of the unkeyed payload hashes,
+	 * which are only needed when an item was actually dropped.
+	 */
+	if (kept != n_items && false == payloads.empty()) {
+		std::vector< uint64_t > hashes(payloads.size());
+
+		batch_hash_t::jenkins(payloads.data(), payloads.size(), hashes.data());
+
+		for (std::size_t idx = 0; idx < hashes.size(); idx++)
+			xor_hash ^= hashes[idx];
+	}
+
+	eobj->object.type	= object_type_t::OBJECT_ENTRY;
+	eobj->object.flags	= entry->object.flags;
+	eobj->object.size	= get_uint64(offsetof(entry_object_t, items) + kept * sizeof(entry_item_t));
+	eobj->realtime		= entry->entry.realtime;
+	eobj->monotonic		= entry->entry.monotonic;
+	eobj->boot_id[0]	= entry->entry.boot_id[0];
+	eobj->boot_id[1]	= entry->entry.boot_id[1];
+	eobj->xor_hash		= (kept == n_items ? entry->entry.xor_hash : get_uint64(xor_hash));
+
+	append_entry_internal(eobj, nullptr, nullptr, nullptr);
+	delete[] reinterpret_cast< uint8_t* >(eobj);
+	return true;
+}
+
+void
+output_journal_t::write_entry(const uint64_t realtime, const uint64_t monotonic, const uint128_vec_t& boot_id, const hash_input_t* payloads, const std::size_t cnt)
+{
+	std::vector< uint64_t >	hashes(cnt), xor_hashes;
+	std::vector< uint8_t >	buf;
+	entry_object_t*			eobj(nullptr);
+	uint64_t				xor_hash(0);
+
+	if (nullptr == payloads || 0 == cnt)
+		throw journal_parameter_error_t("output_journal_t::write_entry(): invalid parameter (nullptr/0 items)");
+	if (! VALID_REALTIME(realtime) || ! VALID_MONOTONIC(monotonic))
+		throw journal_invalid_logic_error_t("output_journal_t::write_entry(): invalid timestamp(s) in entry");
+
+	/*
+	 * Entries built from raw payloads (rather than from another journal)
+	 * have no hashes yet; they are all computed in one batch, plus the
+	 * unkeyed ones for the xor hash when the file uses keyed hashing.
+	 */
+	hash_data(payloads, cnt, hashes.data());
+
+	if (JOURNAL_HEADER_KEYED_HASH(m_incompatible_flags)) {
+		xor_hashes.resize(cnt);
+		batch_hash_t::jenkins(payloads, cnt, xor_hashes.data());
+	}
+
+	eobj = reinterpret_cast< entry_object_t* >(new uint8_t[sizeof(entry_object_t) + cnt * sizeof(entry_item_t)]);
+	std::memset(eobj, 0, sizeof(entry_object_t) + cnt * sizeof(entry_item_t));
+
+	for (std::size_t idx = 0; idx < cnt; idx++) {
+		const std::size_t	osize(offsetof(data_object_t, payload) + payloads[idx].size);
+		data_object_t*		dobj(nullptr);
+		object_t*			o(nullptr);
+		uint64_t			p(0);
+
+		if (buf.size() < osize)
+			buf.resize(osize);
+
+		std::memset(buf.data(), 0, offsetof(data_object_t, payload));
+		std::memcpy(buf.data() + offsetof(data_object_t, payload), payloads[idx].data, payloads[idx].size);
+
+		dobj 				= reinterpret_cast< data_object_t* >(buf.data());
+		dobj->object.type 	= object_type_t::OBJECT_DATA;
+		dobj->object.size 	= get_uint64(osize);
+		dobj->hash			= get_uint64(hashes[idx]);
+
+		append_data(dobj, &o, &p);
+
+		eobj->items[idx].object_offset 	= get_uint64(p);
+		eobj->items[idx].hash			= get_uint64(hashes[idx]);
+		xor_hash 						^= (true == xor_hashes.empty() ? hashes[idx] : xor_hashes[idx]);
+	}
+
+	eobj->object.type	= object_type_t::OBJECT_ENTRY;
+	eobj->object.size	= get_uint64(offsetof(entry_object_t, items) + cnt * sizeof(entry_item_t));
+	eobj->realtime		= get_uint64(realtime);
+	eobj->monotonic		= get_uint64(monotonic);
+	eobj->boot_id[0]	= get_uint64(boot_id[0]);
+	eobj->boot_id[1]	= get_uint64(boot_id[1]);
+	eobj->xor_hash		= get_uint64(xor_hash);
+
+	append_entry_internal(eobj, nullptr, nullptr, nullptr);
+	delete[] reinterpret_cast< uint8_t* >(eobj);
+	return;
+}
+
+void
+output_journal_t::end_write(void)
+{
+	TRACE_SCOPE("output_journal_t::end_write");
+
+	output_file_t 	ofile(m_name.c_str());
+	uint64_t		used(m_size);
+
+	/* the arena grows in large steps; only the part holding objects is written */
+	if (0 != m_tail_object_offset) {
+		object_t* tail(nullptr);
+
+		move_to_object(object_type_t::OBJECT_UNUSED, m_tail_object_offset, &tail);
+		used 			= m_tail_object_offset + ALIGN64(get_uint64(tail->object.size));
+		m_arena_size 	= used - m_header_size;
 	}
 
 	write_header();
 	ofile.open();
-	ofile.write(m_ptr, m_size);
+	ofile.write(m_ptr, used);
 	ofile.close();
-	return true; 
+	return;
 }
 
+void
+output_journal_t::size_hint(const uint64_t size)
+{
+	m_size_hint = size;
+	return;
+}
@@ -5,8 +5,10 @@
 #include <string>
 #include <cstring>
 #include <vector>
-#include <list>
 #include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
 
 #include "global.hpp"
 #include "file.hpp"
@@ -18,17 +20,22 @@
 #include "intstring.hpp"
 #include "log.hpp"
 
+typedef enum
+{
+	ORDER_SEQNUM = 0,
+	ORDER_REALTIME,
+	ORDER_MAX
+} entry_order_t;
+
 class output_journal_t : public journal_base_t
 {
 	private:
 	protected:
 		hash_item_t*	m_data_hash_table;
 		hash_item_t*	m_field_hash_table;
+		uint64_t		m_size_hint;
 
-		virtual bool has_data_object(const data_obj_t&) const;
-		virtual bool has_field_object(const field_obj_t&) const;
-		virtual bool split_field_value(const std::string&, std::string&) const;
-		virtual bool find_field_value(const std::string&, field_obj_t&) const;
+		std::unordered_map< uint64_t, std::pair< uint64_t, uint64_t > >	m_entry_array_tails;
 
 		virtual bool allocate(const uint64_t, const uint64_t);
 		
@@ -36,15 +43,13 @@ class output_journal_t : public journal_base_t
 		virtual void append_field(const field_object_t*, const void*, const std::size_t, object_t**, uint64_t*);
 		virtual void append_data(const data_object_t*, object_t**, uint64_t*);
 		virtual void append_entry_internal(const entry_object_t*, uint64_t*, object_t**, uint64_t*);
-		virtual void append_entry(const entry_obj_t*, uint64_t*, object_t**, uint64_t*, bool p = false);
 		
 		virtual void link_data(object_t*, const uint64_t, const uint64_t);
 		virtual void link_field(object_t*, const uint64_t, const uint64_t);
-		virtual void link_entry_into_array(data_object_t*, uint64_t*, const uint64_t); 
 		virtual void link_entry_into_array(uint64_t*, uint64_t*, const uint64_t);
 		virtual void link_entry_item(object_t*, const entry_item_t*, const uint64_t);
 		virtual void link_entry_into_array_plus_one(uint64_t*, uint64_t*, uint64_t*, const uint64_t);
-		virtual void link_entry_into_array_plus_one(data_object_t*, const uint64_t);
+		virtual void link_entry_into_array_plus_one(const uint64_t, const uint64_t);
 		virtual void link_entry(object_t*, const uint64_t);
 		
 		virtual const uint64_t entry_seqnum(uint64_t*);
@@ -65,10 +70,13 @@ class output_journal_t : public journal_base_t
 	public:
 		output_journal_t(void);
 		output_journal_t(const char*);
-		output_journal_t(const journal_base_t&);
 
 		virtual ~output_journal_t(void);
 
-		virtual void update(std::list< entry_obj_t >&);
-		virtual bool write(void);
+		virtual void size_hint(const uint64_t);
+
+		virtual void begin_write(void);
+		virtual bool write_entry(const journal_base_t&, const object_t*, const std::vector< uint64_t >&);
+		virtual void write_entry(const uint64_t, const uint64_t, const uint128_vec_t&, const hash_input_t*, const std::size_t);
+		virtual void end_write(void);
 };
@@ -0,0 +1,134 @@
+#include "perf.hpp"
+
+perf_counters_t::perf_counters_t(void)
+{
+	for (std::size_t idx = 0; idx < PERF_COUNTER_MAX; idx++)
+		m_fd[idx] = -1;
+
+	return;
+}
+
+perf_counters_t::~perf_counters_t(void)
+{
+	close();
+	return;
+}
+
+signed int
+perf_counters_t::open_counter(const uint32_t type, const uint64_t config) const
+{
+	struct perf_event_attr 	attr;
+	signed int				fd(-1);
+
+	std::memset(&attr, 0, sizeof(attr));
+
+	attr.size			= sizeof(attr);
+	attr.type			= type;
+	attr.config			= config;
+	attr.inherit		= 1;
+	attr.exclude_hv		= 1;
+	attr.read_format	= PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	fd = static_cast< signed int >(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+
+	/* unprivileged processes are commonly restricted to user space events */
+	if (0 > fd) {
+		attr.exclude_kernel = 1;
+		fd = static_cast< signed int >(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+
+	return fd;
+}
+
+const bool
+perf_counters_t::open(void)
+{
+	close();
+
+	m_fd[PERF_CYCLES] 			= open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	m_fd[PERF_INSTRUCTIONS] 	= open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	m_fd[PERF_CACHE_MISSES] 	= open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	m_fd[PERF_BRANCH_MISSES] 	= open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+	m_fd[PERF_PAGE_FAULTS] 		= open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+
+	return available();
+}
+
+void
+perf_counters_t::close(void)
+{
+	for (std::size_t idx = 0; idx < PERF_COUNTER_MAX; idx++) {
+		if (0 <= m_fd[idx])
+			::close(m_fd[idx]);
+
+		m_fd[idx] = -1;
+	}
+
+	return;
+}
+
+const bool
+perf_counters_t::available(void) const
+{
+	for (std::size_t idx = 0; idx < PERF_COUNTER_MAX; idx++)
+		if (0 <= m_fd[idx])
+			return true;
+
+	return false;
+}
+
+void
+perf_counters_t::read(perf_sample_t& sample) const
+{
+	for (std::size_t idx = 0; idx < PERF_COUNTER_MAX; idx++) {
+		uint64_t buf[3] = { 0, 0, 0 };
+
+		sample.value[idx] = 0;
+		sample.valid[idx] = false;
+
+		if (0 > m_fd[idx] || sizeof(buf) != ::read(m_fd[idx], buf, sizeof(buf)))
+			continue;
+
+		/* buf: value, time enabled, time running */
+		if (0 != buf[2] && buf[2] < buf[1])
+			buf[0] = static_cast< uint64_t >(static_cast< long double >(buf[0]) * buf[1] / buf[2]);
+
+		sample.value[idx] = buf[0];
+		sample.valid[idx] = true;
+	}
+
+	return;
+}
+
+void
+perf_counters_t::delta(const perf_sample_t& start, const perf_sample_t& end, perf_sample_t& out)
+{
+	for (std::size_t idx = 0; idx < PERF_COUNTER_MAX; idx++) {
+		out.valid[idx] = (true == start.valid[idx] && true == end.valid[idx]);
+		out.value[idx] = (true == out.valid[idx] && end.value[idx] > start.value[idx] ? end.value[idx] - start.value[idx] : 0);
+	}
+
+	return;
+}
+
+const char*
+perf_counters_t::name(const perf_counter_t counter)
+{
+	switch (counter) {
+		case PERF_CYCLES:
+			return "cycles";
+		case PERF_INSTRUCTIONS:
+			return "instructions";
+		case PERF_CACHE_MISSES:
+			return "cache_misses";
+		case PERF_BRANCH_MISSES:
+			return "branch_misses";
+		case PERF_PAGE_FAULTS:
+			return "page_faults";
+		default:
+			break;
+	}
+
+	throw std::invalid_argument("perf_counters_t::name(): invalid counter");
+	return nullptr;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "global.hpp"
+#include "exception.hpp"
+
+typedef enum {
+	PERF_CYCLES = 0,
+	PERF_INSTRUCTIONS,
+	PERF_CACHE_MISSES,
+	PERF_BRANCH_MISSES,
+	PERF_PAGE_FAULTS,
+	PERF_COUNTER_MAX
+} perf_counter_t;
+
+typedef struct {
+	uint64_t	value[PERF_COUNTER_MAX];
+	bool		valid[PERF_COUNTER_MAX];
+} perf_sample_t;
+
+/*
+ * Hardware (and page fault) counters for the whole process via
+ * perf_event_open(2). Counters are inherited by threads created after
+ * open(); a worker's counts are folded into the totals when it exits,
+ * which the thread pools do before a phase ends. Each counter is opened
+ * on its own, so whichever the kernel or the container refuses are simply
+ * reported as unavailable, and the values are scaled up if the kernel had
+ * to multiplex them.
+ */
+class perf_counters_t
+{
+	private:
+		perf_counters_t(const perf_counters_t&)				= delete;
+		perf_counters_t& operator=(const perf_counters_t&)	= delete;
+
+	protected:
+		signed int	m_fd[PERF_COUNTER_MAX];
+
+		virtual signed int open_counter(const uint32_t, const uint64_t) const;
+
+	public:
+		perf_counters_t(void);
+		virtual ~perf_counters_t(void);
+
+		virtual const bool open(void);
+		virtual void close(void);
+		virtual const bool available(void) const;
+
+		virtual void read(perf_sample_t&) const;
+
+		static void delta(const perf_sample_t&, const perf_sample_t&, perf_sample_t&);
+		static const char* name(const perf_counter_t);
+};
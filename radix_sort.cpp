@@ -0,0 +1,101 @@
+#include "radix_sort.hpp"
+
+void
+radix_sort_t::histogram(const sort_key_t* keys, const std::size_t cnt, const unsigned int shift, uint64_t* counts)
+{
+	for (std::size_t idx = 0; idx < cnt; idx++)
+		counts[(keys[idx].key >> shift) & (RADIX_BUCKETS - 1)]++;
+
+	return;
+}
+
+void
+radix_sort_t::scatter(const sort_key_t* src, const std::size_t cnt, const unsigned int shift, uint64_t* offsets, sort_key_t* dst)
+{
+	for (std::size_t idx = 0; idx < cnt; idx++)
+		dst[offsets[(src[idx].key >> shift) & (RADIX_BUCKETS - 1)]++] = src[idx];
+
+	return;
+}
+
+void
+radix_sort_t::run(thread_pool_t* pool, const std::size_t nblocks, const std::function< void(const std::size_t) >& fn)
+{
+	if (nullptr == pool || 1 == nblocks) {
+		for (std::size_t blk = 0; blk < nblocks; blk++)
+			fn(blk);
+
+		return;
+	}
+
+	for (std::size_t blk = 0; blk < nblocks; blk++)
+		pool->submit([&fn, blk] { fn(blk); });
+
+	pool->wait();
+	return;
+}
+
+void
+radix_sort_t::sort(std::vector< sort_key_t >& keys, thread_pool_t* pool)
+{
+	const std::size_t			cnt(keys.size());
+	const std::size_t			nblocks(nullptr == pool || RADIX_PARALLEL_MIN > cnt ? 1 : pool->size());
+	const std::size_t			chunk(DIV_ROUND_UP(cnt, nblocks));
+	std::vector< sort_key_t >	tmp;
+	std::vector< uint64_t >		counts(nblocks * RADIX_BUCKETS);
+	sort_key_t*					src(keys.data());
+	sort_key_t*					dst(nullptr);
+
+	if (2 > cnt)
+		return;
+
+	tmp.resize(cnt);
+	dst = tmp.data();
+
+	for (unsigned int shift = 0; shift < 64; shift += RADIX_BITS) {
+		uint64_t	total(0);
+		bool		trivial(false);
+
+		std::fill(counts.begin(), counts.end(), 0);
+
+		run(pool, nblocks, [src, cnt, chunk, shift, &counts] (const std::size_t blk) {
+			const std::size_t begin(std::min(cnt, blk * chunk));
+
+			histogram(src + begin, std::min(cnt, begin + chunk) - begin, shift, &counts[blk * RADIX_BUCKETS]);
+		});
+
+		for (std::size_t dig = 0; dig < RADIX_BUCKETS && false == trivial; dig++) {
+			uint64_t n(0);
+
+			for (std::size_t blk = 0; blk < nblocks; blk++)
+				n += counts[blk * RADIX_BUCKETS + dig];
+
+			trivial = (cnt == n);
+		}
+
+		if (true == trivial)
+			continue;
+
+		for (std::size_t dig = 0; dig < RADIX_BUCKETS; dig++) {
+			for (std::size_t blk = 0; blk < nblocks; blk++) {
+				const uint64_t n(counts[blk * RADIX_BUCKETS + dig]);
+
+				counts[blk * RADIX_BUCKETS + dig] 	= total;
+				total 								+= n;
+			}
+		}
+
+		run(pool, nblocks, [src, dst, cnt, chunk, shift, &counts] (const std::size_t blk) {
+			const std::size_t begin(std::min(cnt, blk * chunk));
+
+			scatter(src + begin, std::min(cnt, begin + chunk) - begin, shift, &counts[blk * RADIX_BUCKETS], dst);
+		});
+
+		std::swap(src, dst);
+	}
+
+	if (src != keys.data())
+		keys.swap(tmp);
+
+	return;
+}
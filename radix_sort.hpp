@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "thread_pool.hpp"
+
+#define RADIX_BITS 			8
+#define RADIX_BUCKETS 		(1 << RADIX_BITS)
+#define RADIX_PARALLEL_MIN 	65536
+
+typedef struct {
+	uint64_t	key;
+	uint32_t	index;
+} sort_key_t;
+
+/*
+ * Stable LSD radix sort of (key, index) pairs, one byte of the key per 
+ * pass. A pass whose byte is the same for every key (the high bytes of
+ * timestamps and sequence numbers nearly always are) is skipped.
+ *
+ * Given a pool, every pass splits the keys into one contiguous block per
+ * worker: the blocks are counted concurrently, the bucket offsets are laid
+ * out block by block within each bucket and each block then scatters into
+ * its own slots, which keeps the sort stable.
+ */
+class radix_sort_t
+{
+	private:
+	protected:
+		static void histogram(const sort_key_t*, const std::size_t, const unsigned int, uint64_t*);
+		static void scatter(const sort_key_t*, const std::size_t, const unsigned int, uint64_t*, sort_key_t*);
+		static void run(thread_pool_t*, const std::size_t, const std::function< void(const std::size_t) >&);
+
+	public:
+		static void sort(std::vector< sort_key_t >&, thread_pool_t* pool = nullptr);
+};
@@ -92,10 +92,10 @@ siphash_t::compress(const void* _in, const std::size_t inlen)
 		round();
 		m_v0 		^= m_padding;
 		m_padding 	= 0;
-
-		end -= (m_inlen % sizeof(uint64_t));
 	}
 
+	end -= (m_inlen % sizeof(uint64_t));
+
 	for (; in < end; in += 8) {
 		m = get_uint64(*reinterpret_cast< const uint64_t * >(in));
 
@@ -27,7 +27,7 @@ class siphash_t
 		static inline const uint64_t
 		rotate_left(uint64_t x, uint8_t b)
 		{
-			if (64 >= b)
+			if (0 == b || 64 <= b)
 				throw std::invalid_argument("siphash_t::rotate_left(): invalid bit-length parameter");
 
 			return (x << b) | (x >> (64 - b));
@@ -103,3 +103,112 @@ class siphash_t
 		}
 
 };
+
+/*
+ * One-shot SipHash-2-4 for the journal keyed hash. Every DATA and FIELD
+ * hash in a keyed file uses the same key (the file id), so the initial 
+ * state derived from it is computed once per journal with siphash24_key() 
+ * and the per-call work is limited to the compression and finalisation 
+ * rounds. Unlike siphash_t nothing here is virtual, so the whole hash can 
+ * be inlined into callers.
+ */
+typedef struct {
+	uint64_t	v0;
+	uint64_t	v1;
+	uint64_t	v2;
+	uint64_t	v3;
+} siphash_key_t;
+
+#define SIPHASH_ROTL(x, b) static_cast< uint64_t >(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPHASH_ROUND(v0, v1, v2, v3) 	\
+	do { 								\
+		v0 += v1;						\
+		v1 = SIPHASH_ROTL(v1, 13);		\
+		v1 ^= v0;						\
+		v0 = SIPHASH_ROTL(v0, 32);		\
+		v2 += v3;						\
+		v3 = SIPHASH_ROTL(v3, 16);		\
+		v3 ^= v2;						\
+		v0 += v3;						\
+		v3 = SIPHASH_ROTL(v3, 21);		\
+		v3 ^= v0;						\
+		v2 += v1;						\
+		v1 = SIPHASH_ROTL(v1, 17);		\
+		v1 ^= v2;						\
+		v2 = SIPHASH_ROTL(v2, 32);		\
+	} while (0)
+
+static inline const siphash_key_t
+siphash24_key(const sbarray_t& k)
+{
+	siphash_key_t	key;
+	uint64_t		k0(0), k1(0);
+
+	std::memcpy(&k0, &k[0], sizeof(uint64_t));
+	std::memcpy(&k1, &k[sizeof(uint64_t)], sizeof(uint64_t));
+
+	k0 = get_uint64(k0);
+	k1 = get_uint64(k1);
+
+	/* "somepseudorandomlygeneratedbytes" */
+	key.v0 = 0x736f6d6570736575ULL ^ k0;
+	key.v1 = 0x646f72616e646f6dULL ^ k1;
+	key.v2 = 0x6c7967656e657261ULL ^ k0;
+	key.v3 = 0x7465646279746573ULL ^ k1;
+
+	return key;
+}
+
+static inline const uint64_t
+siphash24(const void* data, const std::size_t len, const siphash_key_t& key)
+{
+	const uint8_t*	in(static_cast< const uint8_t* >(data));
+	const uint8_t*	end(in + (len & ~static_cast< std::size_t >(7)));
+	uint64_t		v0(key.v0), v1(key.v1), v2(key.v2), v3(key.v3);
+	uint64_t		b(static_cast< uint64_t >(len) << 56);
+
+	for (; in < end; in += 8) {
+		uint64_t m(0);
+
+		std::memcpy(&m, in, sizeof(uint64_t));
+		m = get_uint64(m);
+
+		v3 ^= m;
+		SIPHASH_ROUND(v0, v1, v2, v3);
+		SIPHASH_ROUND(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+
+	switch (len & 7) {
+		case 7:
+			b |= static_cast< uint64_t >(in[6]) << 48;
+		case 6:
+			b |= static_cast< uint64_t >(in[5]) << 40;
+		case 5:
+			b |= static_cast< uint64_t >(in[4]) << 32;
+		case 4:
+			b |= static_cast< uint64_t >(in[3]) << 24;
+		case 3:
+			b |= static_cast< uint64_t >(in[2]) << 16;
+		case 2:
+			b |= static_cast< uint64_t >(in[1]) << 8;
+		case 1:
+			b |= static_cast< uint64_t >(in[0]);
+		default:
+			break;
+	}
+
+	v3 ^= b;
+	SIPHASH_ROUND(v0, v1, v2, v3);
+	SIPHASH_ROUND(v0, v1, v2, v3);
+	v0 ^= b;
+
+	v2 ^= 0xFF;
+	SIPHASH_ROUND(v0, v1, v2, v3);
+	SIPHASH_ROUND(v0, v1, v2, v3);
+	SIPHASH_ROUND(v0, v1, v2, v3);
+	SIPHASH_ROUND(v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
@@ -0,0 +1,194 @@
+#include "stats.hpp"
+
+stats_t::stats_t(void)
+	: m_start(std::chrono::steady_clock::now()), m_phase_start(m_start), m_open(false), m_perf(nullptr)
+{
+	m_perf_start = perf_sample_t();
+	return;
+}
+
+stats_t::~stats_t(void)
+{
+	m_phases.clear();
+	m_counters.clear();
+	return;
+}
+
+const uint64_t
+stats_t::per_second(const uint64_t count, const uint64_t usec)
+{
+	if (0 == usec)
+		return 0;
+
+	return static_cast< uint64_t >((static_cast< long double >(count) * 1000000) / usec);
+}
+
+void
+stats_t::begin(const std::string& name)
+{
+	phase_stat_t phase = { name, 0, 0, 0, 0, perf_sample_t() };
+
+	if (true == m_open)
+		end();
+
+	m_phases.push_back(phase);
+
+	if (nullptr != m_perf)
+		m_perf->read(m_perf_start);
+
+	m_phase_start 	= std::chrono::steady_clock::now();
+	m_open 			= true;
+	return;
+}
+
+void
+stats_t::end(const uint64_t objects, const uint64_t bytes)
+{
+	if (false == m_open)
+		throw std::runtime_error("stats_t::end(): no phase in progress");
+
+	m_phases.back().usec 	= std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - m_phase_start).count();
+	m_phases.back().objects = objects;
+	m_phases.back().bytes 	= bytes;
+	m_phases.back().rss		= peak_rss();
+
+	if (nullptr != m_perf) {
+		perf_sample_t now;
+
+		m_perf->read(now);
+		perf_counters_t::delta(m_perf_start, now, m_phases.back().perf);
+	}
+
+	m_open 					= false;
+	return;
+}
+
+void
+stats_t::counter(const std::string& name, const uint64_t value)
+{
+	for (std::size_t idx = 0; idx < m_counters.size(); idx++) {
+		if (m_counters[idx].first == name) {
+			m_counters[idx].second = value;
+			return;
+		}
+	}
+
+	m_counters.push_back(std::make_pair(name, value));
+	return;
+}
+
+void
+stats_t::counters(const perf_counters_t* perf)
+{
+	m_perf = perf;
+	return;
+}
+
+const std::vector< phase_stat_t >&
+stats_t::phases(void) const
+{
+	return m_phases;
+}
+
+const uint64_t
+stats_t::total_usec(void) const
+{
+	return std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - m_start).count();
+}
+
+const uint64_t
+stats_t::peak_rss(void)
+{
+	struct rusage ru;
+
+	if (0 != ::getrusage(RUSAGE_SELF, &ru))
+		return 0;
+
+	// ru_maxrss is reported in kilobytes on Linux
+	return static_cast< uint64_t >(ru.ru_maxrss) * 1024;
+}
+
+void
+stats_t::print(void) const
+{
+	INFO("Timings:");
+
+	for (std::size_t idx = 0; idx < m_phases.size(); idx++) {
+		const phase_stat_t& 	p(m_phases[idx]);
+		std::ostringstream		line;
+
+		line << "  " << p.name << ": " << (p.usec / 1000) << "." << ((p.usec % 1000) / 100) << "ms";
+
+		if (0 != p.objects)
+			line << ", " << p.objects << " objects (" << per_second(p.objects, p.usec) << "/s)";
+
+		if (0 != p.bytes)
+			line << ", " << p.bytes << " bytes (" << per_second(p.bytes, p.usec) / (1024 * 1024) << " MiB/s)";
+
+		line << ", peak RSS: " << (p.rss / 1024) << " KiB";
+
+		if (true == p.perf.valid[PERF_CYCLES] && true == p.perf.valid[PERF_INSTRUCTIONS] && 0 != p.perf.value[PERF_CYCLES])
+			line << ", IPC: " << std::fixed << std::setprecision(2)
+				 << static_cast< double >(p.perf.value[PERF_INSTRUCTIONS]) / p.perf.value[PERF_CYCLES];
+
+		for (std::size_t cnt = 0; cnt < PERF_COUNTER_MAX; cnt++)
+			if (true == p.perf.valid[cnt])
+				line << ", " << perf_counters_t::name(static_cast< perf_counter_t >(cnt)) << ": " << p.perf.value[cnt];
+
+		INFO(line.str());
+	}
+
+	INFO("  Total: ", total_usec() / 1000, "ms, peak RSS: ", peak_rss() / 1024, " KiB");
+
+	for (std::size_t idx = 0; idx < m_counters.size(); idx++)
+		INFO("  ", m_counters[idx].first, ": ", m_counters[idx].second);
+
+	return;
+}
+
+const std::string
+stats_t::to_json(void) const
+{
+	std::ostringstream json;
+
+	json << "{\"phases\":[";
+
+	for (std::size_t idx = 0; idx < m_phases.size(); idx++) {
+		const phase_stat_t& p(m_phases[idx]);
+
+		json << (0 == idx ? "" : ",")
+			 << "{\"name\":\"" << p.name << "\""
+			 << ",\"usec\":" << p.usec
+			 << ",\"objects\":" << p.objects
+			 << ",\"bytes\":" << p.bytes
+			 << ",\"objects_per_sec\":" << per_second(p.objects, p.usec)
+			 << ",\"bytes_per_sec\":" << per_second(p.bytes, p.usec)
+			 << ",\"peak_rss\":" << p.rss;
+
+		for (std::size_t cnt = 0; cnt < PERF_COUNTER_MAX; cnt++)
+			if (true == p.perf.valid[cnt])
+				json << ",\"" << perf_counters_t::name(static_cast< perf_counter_t >(cnt)) << "\":" << p.perf.value[cnt];
+
+		json << "}";
+	}
+
+	json << "],\"counters\":{";
+
+	for (std::size_t idx = 0; idx < m_counters.size(); idx++)
+		json << (0 == idx ? "" : ",") << "\"" << m_counters[idx].first << "\":" << m_counters[idx].second;
+
+	json << "},\"total_usec\":" << total_usec() << ",\"peak_rss\":" << peak_rss() << "}";
+	return json.str();
+}
+
+const bool
+stats_t::write_json(const std::string& path) const
+{
+	std::ofstream out(path.c_str(), std::ios::out | std::ios::trunc);
+
+	if (false == out.is_open())
+		return false;
+
+	out << to_json() << std::endl;
+	return out.good();
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "log.hpp"
+#include "perf.hpp"
+
+typedef struct {
+	std::string		name;
+	uint64_t		usec;
+	uint64_t		objects;
+	uint64_t		bytes;
+	uint64_t		rss;
+	perf_sample_t	perf;
+} phase_stat_t;
+
+/*
+ * Run statistics: wall clock time per phase with optional object and byte
+ * counts for throughput, plus free-form named counters. Phases are strictly
+ * sequential; begin() closes whichever phase is still open. Each phase also
+ * records the peak RSS of the process as of its end, i.e. the high water
+ * mark reached by that phase or any before it. When given a set of perf
+ * counters, the counts accumulated during each phase are recorded too.
+ */
+class stats_t
+{
+	private:
+		stats_t(const stats_t&)				= delete;
+		stats_t& operator=(const stats_t&)	= delete;
+
+	protected:
+		std::vector< phase_stat_t >						m_phases;
+		std::vector< std::pair< std::string, uint64_t > >	m_counters;
+		std::chrono::steady_clock::time_point			m_start;
+		std::chrono::steady_clock::time_point			m_phase_start;
+		bool											m_open;
+		const perf_counters_t*							m_perf;
+		perf_sample_t									m_perf_start;
+
+		static const uint64_t per_second(const uint64_t, const uint64_t);
+
+	public:
+		stats_t(void);
+		virtual ~stats_t(void);
+
+		virtual void begin(const std::string&);
+		virtual void end(const uint64_t objects = 0, const uint64_t bytes = 0);
+
+		virtual void counter(const std::string&, const uint64_t);
+		virtual void counters(const perf_counters_t*);
+
+		virtual const std::vector< phase_stat_t >& phases(void) const;
+		virtual const uint64_t total_usec(void) const;
+
+		virtual void print(void) const;
+		virtual const std::string to_json(void) const;
+		virtual const bool write_json(const std::string&) const;
+
+		static const uint64_t peak_rss(void);
+};
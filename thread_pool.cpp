@@ -0,0 +1,140 @@
+#include "thread_pool.hpp"
+
+thread_pool_t::thread_pool_t(const std::size_t nthreads)
+	: m_pending(0), m_error(nullptr), m_stop(false)
+{
+	const std::size_t cnt(0 == nthreads ? default_size() : nthreads);
+
+	for (std::size_t idx = 0; idx < cnt; idx++)
+		m_workers.push_back(std::thread(&thread_pool_t::worker, this));
+
+	return;
+}
+
+thread_pool_t::~thread_pool_t(void)
+{
+	{
+		std::unique_lock< std::mutex > lck(m_mutex);
+		m_stop = true;
+	}
+
+	m_work_cv.notify_all();
+
+	for (std::size_t idx = 0; idx < m_workers.size(); idx++)
+		if (true == m_workers[idx].joinable())
+			m_workers[idx].join();
+
+	return;
+}
+
+const std::size_t
+thread_pool_t::default_size(void)
+{
+	const std::size_t cnt(std::thread::hardware_concurrency());
+
+	return (0 == cnt ? 1 : cnt);
+}
+
+const std::size_t
+thread_pool_t::size(void) const
+{
+	return m_workers.size();
+}
+
+void
+thread_pool_t::worker(void)
+{
+	for (;;) {
+		std::function< void(void) > job;
+
+		{
+			std::unique_lock< std::mutex > lck(m_mutex);
+
+			m_work_cv.wait(lck, [this] { return true == m_stop || false == m_queue.empty(); });
+
+			if (true == m_stop && true == m_queue.empty())
+				return;
+
+			job = m_queue.front();
+			m_queue.pop();
+		}
+
+		try {
+			job();
+		} catch (...) {
+			std::unique_lock< std::mutex > lck(m_mutex);
+
+			if (nullptr == m_error)
+				m_error = std::current_exception();
+		}
+
+		{
+			std::unique_lock< std::mutex > lck(m_mutex);
+
+			if (0 == --m_pending)
+				m_done_cv.notify_all();
+		}
+	}
+
+	return;
+}
+
+void
+thread_pool_t::submit(const std::function< void(void) >& job)
+{
+	{
+		std::unique_lock< std::mutex > lck(m_mutex);
+
+		if (true == m_stop)
+			throw std::runtime_error("thread_pool_t::submit(): submission to stopped pool");
+
+		m_queue.push(job);
+		m_pending++;
+	}
+
+	m_work_cv.notify_one();
+	return;
+}
+
+void
+thread_pool_t::wait(void)
+{
+	std::exception_ptr err(nullptr);
+
+	{
+		std::unique_lock< std::mutex > lck(m_mutex);
+
+		m_done_cv.wait(lck, [this] { return 0 == m_pending; });
+		err 	= m_error;
+		m_error = nullptr;
+	}
+
+	if (nullptr != err)
+		std::rethrow_exception(err);
+
+	return;
+}
+
+void
+thread_pool_t::parallel_for(const std::size_t cnt, const std::function< void(const std::size_t, const std::size_t) >& fn)
+{
+	std::size_t chunk(0);
+
+	if (0 == cnt)
+		return;
+
+	/*
+	 * A few chunks per worker rather than one so that a slow range (large
+	 * entries, cold pages) doesn't leave the rest of the pool idle.
+	 */
+	chunk = DIV_ROUND_UP(cnt, m_workers.size() * 4);
+
+	for (std::size_t begin = 0; begin < cnt; begin += chunk) {
+		const std::size_t end(std::min(cnt, begin + chunk));
+
+		submit([&fn, begin, end] { fn(begin, end); });
+	}
+
+	wait();
+	return;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "log.hpp"
+
+/*
+ * Fixed-size pool of worker threads. Work is submitted as closures and
+ * wait() blocks until every submitted closure has run; the first exception
+ * thrown by a closure is captured and rethrown from wait() so callers see
+ * failures the same way they would in the sequential code.
+ */
+class thread_pool_t
+{
+	private:
+		thread_pool_t(const thread_pool_t&) 			= delete;
+		thread_pool_t& operator=(const thread_pool_t&) 	= delete;
+
+	protected:
+		std::vector< std::thread >				m_workers;
+		std::queue< std::function< void(void) > >	m_queue;
+		std::mutex								m_mutex;
+		std::condition_variable					m_work_cv;
+		std::condition_variable					m_done_cv;
+		std::size_t								m_pending;
+		std::exception_ptr						m_error;
+		bool									m_stop;
+
+		virtual void worker(void);
+
+	public:
+		thread_pool_t(const std::size_t nthreads = 0);
+		virtual ~thread_pool_t(void);
+
+		virtual const std::size_t size(void) const;
+
+		virtual void submit(const std::function< void(void) >&);
+		virtual void wait(void);
+
+		virtual void parallel_for(const std::size_t, const std::function< void(const std::size_t, const std::size_t) >&);
+
+		static const std::size_t default_size(void);
+};
@@ -0,0 +1,163 @@
+#include "trace.hpp"
+
+trace_t trace_t::s_instance;
+
+trace_buffer_t::trace_buffer_t(const uint32_t tid)
+	: m_events(TRACE_BUFFER_SIZE), m_next(0), m_dropped(0), m_tid(tid)
+{
+	return;
+}
+
+trace_buffer_t::~trace_buffer_t(void)
+{
+	m_events.clear();
+	m_next 		= 0;
+	m_dropped	= 0;
+	return;
+}
+
+const uint32_t
+trace_buffer_t::tid(void) const
+{
+	return m_tid;
+}
+
+const std::size_t
+trace_buffer_t::size(void) const
+{
+	return m_next;
+}
+
+const uint64_t
+trace_buffer_t::dropped(void) const
+{
+	return m_dropped;
+}
+
+const trace_event_t&
+trace_buffer_t::at(const std::size_t idx) const
+{
+	if (idx >= size())
+		throw std::out_of_range("trace_buffer_t::at(): index out of range");
+
+	return m_events[idx];
+}
+
+trace_t::trace_t(void)
+	: m_enabled(false), m_epoch(std::chrono::steady_clock::now())
+{
+	return;
+}
+
+trace_t::~trace_t(void)
+{
+	std::lock_guard< std::mutex > lck(m_mutex);
+
+	for (std::size_t idx = 0; idx < m_buffers.size(); idx++)
+		delete m_buffers[idx];
+
+	m_buffers.clear();
+	return;
+}
+
+trace_buffer_t*
+trace_t::buffer(void)
+{
+	static thread_local trace_buffer_t* buf(nullptr);
+
+	if (nullptr == buf) {
+		std::lock_guard< std::mutex > lck(m_mutex);
+
+		buf = new trace_buffer_t(static_cast< uint32_t >(m_buffers.size() + 1));
+		m_buffers.push_back(buf);
+	}
+
+	return buf;
+}
+
+void
+trace_t::enable(const bool e)
+{
+	m_enabled.store(e, std::memory_order_relaxed);
+	return;
+}
+
+void
+trace_t::complete(const char* name, const uint64_t start)
+{
+	const uint64_t end(now());
+
+	buffer()->push(name, start, end - start);
+	return;
+}
+
+const uint64_t
+trace_t::dropped(void)
+{
+	std::lock_guard< std::mutex > 	lck(m_mutex);
+	uint64_t						cnt(0);
+
+	for (std::size_t idx = 0; idx < m_buffers.size(); idx++)
+		cnt += m_buffers[idx]->dropped();
+
+	return cnt;
+}
+
+const bool
+trace_t::write(const std::string& path)
+{
+	std::lock_guard< std::mutex > 	lck(m_mutex);
+	std::ofstream 					out(path.c_str(), std::ios::out | std::ios::trunc);
+	bool							first(true);
+	uint64_t						dropped(0);
+
+	if (false == out.is_open())
+		return false;
+
+	out << "{\"traceEvents\":[";
+
+	for (std::size_t b = 0; b < m_buffers.size(); b++) {
+		const trace_buffer_t* buf(m_buffers[b]);
+
+		out << (true == first ? "" : ",")
+			<< "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buf->tid()
+			<< ",\"args\":{\"name\":\"" << (1 == buf->tid() ? "main" : "worker") << "\"}}";
+		first = false;
+
+		for (std::size_t idx = 0; idx < buf->size(); idx++) {
+			const trace_event_t& ev(buf->at(idx));
+
+			out << ",{\"name\":\"" << ev.name << "\",\"ph\":\"X\",\"ts\":" << ev.ts << ",\"dur\":" << ev.dur
+				<< ",\"pid\":1,\"tid\":" << buf->tid() << "}";
+		}
+
+		dropped += buf->dropped();
+	}
+
+	out << "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped << "}}" << std::endl;
+	return out.good();
+}
+
+trace_file_t::trace_file_t(const std::string& name)
+	: m_name(name)
+{
+	if (false == m_name.empty())
+		trace_t::instance().enable(true);
+
+	return;
+}
+
+trace_file_t::~trace_file_t(void)
+{
+	if (true == m_name.empty())
+		return;
+
+	trace_t::instance().enable(false);
+
+	if (false == trace_t::instance().write(m_name))
+		ERROR("Unable to write trace: ", m_name);
+	else if (0 != trace_t::instance().dropped())
+		ERROR("Trace buffers filled up, ", trace_t::instance().dropped(), " events were dropped: ", m_name);
+
+	return;
+}
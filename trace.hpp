@@ -0,0 +1,178 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+
+#include "global.hpp"
+#include "exception.hpp"
+#include "log.hpp"
+
+#define TRACE_BUFFER_SIZE 65536
+
+/* a complete ('X') event: a scope that started at ts and lasted dur */
+typedef struct {
+	const char*		name;
+	uint64_t		ts;
+	uint64_t		dur;
+} trace_event_t;
+
+/*
+ * Per-thread buffer of trace events. Only the owning thread ever appends,
+ * so no locking is needed on the hot path. Once full further events are
+ * counted and dropped rather than overwriting older ones, so the trace
+ * always covers the start of the run.
+ */
+class trace_buffer_t
+{
+	private:
+		trace_buffer_t(const trace_buffer_t&)				= delete;
+		trace_buffer_t& operator=(const trace_buffer_t&)	= delete;
+
+	protected:
+		std::vector< trace_event_t >	m_events;
+		std::size_t						m_next;
+		uint64_t						m_dropped;
+		uint32_t						m_tid;
+
+	public:
+		trace_buffer_t(const uint32_t);
+		virtual ~trace_buffer_t(void);
+
+		inline void
+		push(const char* name, const uint64_t ts, const uint64_t dur)
+		{
+			if (m_next == m_events.size()) {
+				m_dropped++;
+				return;
+			}
+
+			trace_event_t& ev(m_events[m_next++]);
+
+			ev.name = name;
+			ev.ts	= ts;
+			ev.dur	= dur;
+			return;
+		}
+
+		virtual const uint32_t tid(void) const;
+		virtual const std::size_t size(void) const;
+		virtual const uint64_t dropped(void) const;
+		virtual const trace_event_t& at(const std::size_t) const;
+};
+
+/*
+ * Process wide tracer. Events are only recorded while enabled; disabled
+ * tracing costs one relaxed atomic load per scope, the tracer itself being
+ * a static member rather than a function-local static. write() emits the
+ * Chrome trace event format, which chrome://tracing and Perfetto both
+ * load, and must only be called once the traced threads have quiesced.
+ */
+class trace_t
+{
+	private:
+		trace_t(void);
+		trace_t(const trace_t&)				= delete;
+		trace_t& operator=(const trace_t&)	= delete;
+
+		static trace_t							s_instance;
+
+	protected:
+		std::atomic< bool >						m_enabled;
+		std::mutex								m_mutex;
+		std::vector< trace_buffer_t* >			m_buffers;
+		std::chrono::steady_clock::time_point	m_epoch;
+
+		virtual trace_buffer_t* buffer(void);
+
+	public:
+		virtual ~trace_t(void);
+
+		static inline trace_t&
+		instance(void)
+		{
+			return s_instance;
+		}
+
+		inline const bool
+		enabled(void) const
+		{
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+
+		inline const uint64_t
+		now(void) const
+		{
+			return std::chrono::duration_cast< std::chrono::microseconds >(std::chrono::steady_clock::now() - m_epoch).count();
+		}
+
+		virtual void enable(const bool);
+		virtual void complete(const char*, const uint64_t);
+		virtual const uint64_t dropped(void);
+		virtual const bool write(const std::string&);
+};
+
+/*
+ * Records the enclosing scope as one complete event when it ends. Scopes
+ * are meant for phases and per-chunk work; per-object scopes would fill the
+ * buffers within the first few chunks of a large journal.
+ */
+class trace_scope_t
+{
+	private:
+		trace_scope_t(const trace_scope_t&)				= delete;
+		trace_scope_t& operator=(const trace_scope_t&)	= delete;
+
+	protected:
+		const char*	m_name;
+		bool		m_active;
+		uint64_t	m_start;
+
+	public:
+		inline
+		trace_scope_t(const char* name)
+			: m_name(name), m_active(trace_t::instance().enabled()), m_start(0)
+		{
+			if (true == m_active)
+				m_start = trace_t::instance().now();
+
+			return;
+		}
+
+		inline
+		~trace_scope_t(void)
+		{
+			if (true == m_active)
+				trace_t::instance().complete(m_name, m_start);
+
+			return;
+		}
+};
+
+/*
+ * Enables tracing for its lifetime when given a file name and writes the
+ * trace to it when it goes out of scope, so the trace is written however
+ * the traced code is left, errors included.
+ */
+class trace_file_t
+{
+	private:
+		trace_file_t(const trace_file_t&)				= delete;
+		trace_file_t& operator=(const trace_file_t&)	= delete;
+
+	protected:
+		std::string	m_name;
+
+	public:
+		trace_file_t(const std::string&);
+		virtual ~trace_file_t(void);
+};
+
+#define TRACE_CONCAT_INNER(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) trace_scope_t TRACE_CONCAT(trace_scope_, __LINE__)(name)
@@ -0,0 +1,427 @@
+#include "value_index.hpp"
+
+value_index_t::value_index_t(void)
+	: m_map(nullptr), m_map_size(0)
+{
+	reset();
+	return;
+}
+
+value_index_t::~value_index_t(void)
+{
+	reset();
+	return;
+}
+
+void
+value_index_t::reset(void)
+{
+	if (nullptr != m_map)
+		input_file_t::unmap(m_map, m_map_size);
+
+	m_map 			= nullptr;
+	m_map_size		= 0;
+	m_header		= nullptr;
+	m_values		= nullptr;
+	m_fields		= nullptr;
+	m_postings		= nullptr;
+	m_field_values	= nullptr;
+	m_strings		= nullptr;
+
+	return;
+}
+
+bool
+value_index_t::load(const std::string& name, const uint128_vec_t& file_id, const uint64_t tail_entry_seqnum)
+{
+	input_file_t	inf;
+	std::size_t		siz(0), need(sizeof(value_index_header_t));
+	uint64_t		cnt[5] = {0};
+	std::size_t		width[5] = { sizeof(value_index_item_t), sizeof(field_index_item_t), sizeof(uint64_t), sizeof(uint64_t), 1 };
+
+	reset();
+
+	if (0 != ::access(name.c_str(), R_OK))
+		return false;
+
+	inf.open(name.c_str());
+	siz = inf.size();
+
+	if (sizeof(value_index_header_t) > siz) {
+		DEBUG("value_index_t::load(): truncated index file: ", name);
+		return false;
+	}
+
+	m_map 		= inf.map(siz);
+	m_map_size	= siz;
+	m_header	= reinterpret_cast< const value_index_header_t* >(m_map);
+	inf.close();
+
+	if (0 != std::memcmp(&m_header->signature[0], VALUE_INDEX_SIGNATURE, sizeof(m_header->signature)) ||
+		get_uint64(m_header->file_id[0]) != file_id[0] || get_uint64(m_header->file_id[1]) != file_id[1] ||
+		get_uint64(m_header->tail_entry_seqnum) != tail_entry_seqnum) {
+		DEBUG("value_index_t::load(): stale or foreign index file: ", name);
+		reset();
+		return false;
+	}
+
+	cnt[0] = get_uint64(m_header->n_values);
+	cnt[1] = get_uint64(m_header->n_fields);
+	cnt[2] = get_uint64(m_header->n_postings);
+	cnt[3] = get_uint64(m_header->n_field_values);
+	cnt[4] = get_uint64(m_header->strings_size);
+
+	for (std::size_t idx = 0; idx < 5; idx++) {
+		if (cnt[idx] > (siz - need) / width[idx]) {
+			DEBUG("value_index_t::load(): index file counts exceed file size: ", name);
+			reset();
+			return false;
+		}
+
+		need += cnt[idx] * width[idx];
+	}
+
+	if (need != siz) {
+		DEBUG("value_index_t::load(): index file size mismatch: ", name);
+		reset();
+		return false;
+	}
+
+	/* items are consumed straight out of the mapping, see object_index_t::load() */
+#if defined(__BYTE_ORDER__)&&(__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	reset();
+	return false;
+#endif
+
+	m_values		= reinterpret_cast< const value_index_item_t* >(m_map + sizeof(value_index_header_t));
+	m_fields		= reinterpret_cast< const field_index_item_t* >(m_values + cnt[0]);
+	m_postings		= reinterpret_cast< const uint64_t* >(m_fields + cnt[1]);
+	m_field_values	= m_postings + cnt[2];
+	m_strings		= reinterpret_cast< const char* >(m_field_values + cnt[3]);
+
+	/*
+	 * Bounds are checked once here so that the lookups below can trust
+	 * every offset they read out of the mapping.
+	 */
+	for (uint64_t idx = 0; idx < cnt[0]; idx++) {
+		const value_index_item_t& v(m_values[idx]);
+
+		if (v.postings_offset > cnt[2] || v.n_postings > cnt[2] - v.postings_offset ||
+			v.string_offset > cnt[4] || v.string_size > cnt[4] - v.string_offset) {
+			DEBUG("value_index_t::load(): corrupt value item in index file: ", name);
+			reset();
+			return false;
+		}
+	}
+
+	for (uint64_t idx = 0; idx < cnt[1]; idx++) {
+		const field_index_item_t& f(m_fields[idx]);
+
+		if (f.values_offset > cnt[3] || f.n_values > cnt[3] - f.values_offset ||
+			f.string_offset > cnt[4] || f.string_size > cnt[4] - f.string_offset) {
+			DEBUG("value_index_t::load(): corrupt field item in index file: ", name);
+			reset();
+			return false;
+		}
+	}
+
+	for (uint64_t idx = 0; idx < cnt[3]; idx++) {
+		if (m_field_values[idx] >= cnt[0]) {
+			DEBUG("value_index_t::load(): corrupt field value in index file: ", name);
+			reset();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+value_index_t::build(const std::string& name, const journal_base_t& journal)
+{
+	typedef struct {
+		uint64_t				data_offset;
+		std::vector< uint64_t >	seqnums;
+	} value_build_t;
+
+	typedef struct {
+		uint64_t				hash;
+		std::string				name;
+		std::vector< uint64_t >	values;
+	} field_build_t;
+
+	const std::string							tmp(name + ".tmp");
+	std::unordered_map< uint64_t, value_build_t >	values;
+	std::unordered_map< std::string, std::size_t >	field_map;
+	std::vector< field_build_t >				fields;
+	std::vector< uint64_t >						hashes;
+	std::vector< value_index_item_t >			vitems;
+	std::vector< field_index_item_t >			fitems;
+	std::vector< uint64_t >						postings, field_values;
+	std::string									strings;
+	value_index_header_t						hdr;
+	entry_cursor_t								cursor(journal);
+
+	/*
+	 * Entries come off the entry array chain in seqnum order, so every
+	 * posting list is built already sorted.
+	 */
+	while (true == cursor.next()) {
+		const object_t* obj(cursor.object());
+		const uint64_t	seqnum(get_uint64(obj->entry.seqnum));
+
+		for (uint64_t idx = 0; idx < cursor.n_items(); idx++) {
+			value_build_t& v(values[get_uint64(obj->entry.items[idx].hash)]);
+
+			if (true == v.seqnums.empty())
+				v.data_offset = get_uint64(obj->entry.items[idx].object_offset);
+			else if (v.seqnums.back() == seqnum)
+				continue;
+
+			v.seqnums.push_back(seqnum);
+		}
+	}
+
+	for (auto itr = values.begin(); itr != values.end(); itr++)
+		hashes.push_back(itr->first);
+
+	std::sort(hashes.begin(), hashes.end());
+
+	for (std::size_t idx = 0; idx < hashes.size(); idx++) {
+		const value_build_t&	v(values[hashes[idx]]);
+		const object_t*			obj(journal.object_at(OBJECT_DATA, v.data_offset));
+		value_index_item_t		item;
+
+		std::memset(&item, 0, sizeof(value_index_item_t));
+
+		item.hash				= hashes[idx];
+		item.data_offset		= v.data_offset;
+		item.postings_offset	= postings.size();
+		item.n_postings			= v.seqnums.size();
+
+		postings.insert(postings.end(), v.seqnums.begin(), v.seqnums.end());
+
+		/* compressed payloads are indexed by hash only */
+		if (0 == (obj->object.flags & OBJECT_COMPRESSION_MASK)) {
+			const char*			payload(reinterpret_cast< const char* >(&obj->data.payload[0]));
+			const std::size_t	len(get_uint64(obj->object.size) - offsetof(data_object_t, payload));
+			const char*			eq(static_cast< const char* >(std::memchr(payload, '=', len)));
+
+			item.string_offset	= strings.size();
+			item.string_size	= len;
+			strings.append(payload, len);
+
+			if (nullptr != eq && eq != payload) {
+				const std::string	field(payload, eq - payload);
+				auto				fitr(field_map.find(field));
+
+				if (fitr == field_map.end()) {
+					field_build_t f;
+
+					f.hash 	= journal.hash_data(field.data(), field.length());
+					f.name	= field;
+
+					fitr = field_map.insert(std::make_pair(field, fields.size())).first;
+					fields.push_back(f);
+				}
+
+				fields[fitr->second].values.push_back(idx);
+			}
+		}
+
+		vitems.push_back(item);
+	}
+
+	std::sort(fields.begin(), fields.end(), [] (const field_build_t& a, const field_build_t& b) { return a.hash < b.hash; });
+
+	for (std::size_t idx = 0; idx < fields.size(); idx++) {
+		field_index_item_t item;
+
+		std::memset(&item, 0, sizeof(field_index_item_t));
+
+		item.hash			= fields[idx].hash;
+		item.values_offset	= field_values.size();
+		item.n_values		= fields[idx].values.size();
+		item.string_offset	= strings.size();
+		item.string_size	= fields[idx].name.length();
+
+		field_values.insert(field_values.end(), fields[idx].values.begin(), fields[idx].values.end());
+		strings.append(fields[idx].name);
+		fitems.push_back(item);
+	}
+
+	std::memset(&hdr, 0, sizeof(value_index_header_t));
+	std::memcpy(&hdr.signature[0], VALUE_INDEX_SIGNATURE, sizeof(hdr.signature));
+
+	hdr.file_id[0]			= get_uint64(journal.file_id()[0]);
+	hdr.file_id[1]			= get_uint64(journal.file_id()[1]);
+	hdr.tail_entry_seqnum	= get_uint64(journal.tail_entry_seqnum());
+	hdr.n_values			= get_uint64(vitems.size());
+	hdr.n_fields			= get_uint64(fitems.size());
+	hdr.n_postings			= get_uint64(postings.size());
+	hdr.n_field_values		= get_uint64(field_values.size());
+	hdr.strings_size		= get_uint64(strings.size());
+
+	DEBUG("value_index_t::build(): ", to_dec_string(vitems.size()), " values, ", to_dec_string(fitems.size()), " fields, ", 
+			to_dec_string(postings.size()), " postings");
+
+	/* the file is little endian whatever the host order, see the layout in value_index.hpp */
+	for (std::size_t idx = 0; idx < vitems.size(); idx++) {
+		vitems[idx].hash			= get_uint64(vitems[idx].hash);
+		vitems[idx].data_offset		= get_uint64(vitems[idx].data_offset);
+		vitems[idx].postings_offset	= get_uint64(vitems[idx].postings_offset);
+		vitems[idx].n_postings		= get_uint64(vitems[idx].n_postings);
+		vitems[idx].string_offset	= get_uint64(vitems[idx].string_offset);
+		vitems[idx].string_size		= get_uint64(vitems[idx].string_size);
+	}
+
+	for (std::size_t idx = 0; idx < fitems.size(); idx++) {
+		fitems[idx].hash			= get_uint64(fitems[idx].hash);
+		fitems[idx].values_offset	= get_uint64(fitems[idx].values_offset);
+		fitems[idx].n_values		= get_uint64(fitems[idx].n_values);
+		fitems[idx].string_offset	= get_uint64(fitems[idx].string_offset);
+		fitems[idx].string_size		= get_uint64(fitems[idx].string_size);
+	}
+
+	for (std::size_t idx = 0; idx < postings.size(); idx++)
+		postings[idx] = get_uint64(postings[idx]);
+
+	for (std::size_t idx = 0; idx < field_values.size(); idx++)
+		field_values[idx] = get_uint64(field_values[idx]);
+
+	try {
+		output_file_t ofile;
+
+		(void)::unlink(tmp.c_str());
+		ofile.open(tmp.c_str());
+		ofile.write(reinterpret_cast< const uint8_t* >(&hdr), sizeof(value_index_header_t));
+
+		if (0 != vitems.size())
+			ofile.write(reinterpret_cast< const uint8_t* >(vitems.data()), vitems.size() * sizeof(value_index_item_t));
+		if (0 != fitems.size())
+			ofile.write(reinterpret_cast< const uint8_t* >(fitems.data()), fitems.size() * sizeof(field_index_item_t));
+		if (0 != postings.size())
+			ofile.write(reinterpret_cast< const uint8_t* >(postings.data()), postings.size() * sizeof(uint64_t));
+		if (0 != field_values.size())
+			ofile.write(reinterpret_cast< const uint8_t* >(field_values.data()), field_values.size() * sizeof(uint64_t));
+		if (0 != strings.size())
+			ofile.write(reinterpret_cast< const uint8_t* >(strings.data()), strings.size());
+
+		ofile.close();
+	} catch (std::exception& e) {
+		DEBUG("value_index_t::build(): error writing index file: ", e.what());
+		(void)::unlink(tmp.c_str());
+		return false;
+	}
+
+	if (0 != ::rename(tmp.c_str(), name.c_str())) {
+		(void)::unlink(tmp.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+const uint64_t
+value_index_t::n_values(void) const
+{
+	return (nullptr == m_header ? 0 : get_uint64(m_header->n_values));
+}
+
+const uint64_t
+value_index_t::n_fields(void) const
+{
+	return (nullptr == m_header ? 0 : get_uint64(m_header->n_fields));
+}
+
+const value_index_item_t*
+value_index_t::find_hash(const uint64_t hash) const
+{
+	const value_index_item_t* 	end(m_values + n_values());
+	const value_index_item_t*	itr(nullptr);
+
+	if (nullptr == m_header)
+		return nullptr;
+
+	itr = std::lower_bound(m_values, end, hash, [] (const value_index_item_t& v, const uint64_t h) { return v.hash < h; });
+
+	if (itr == end || itr->hash != hash)
+		return nullptr;
+
+	return itr;
+}
+
+const bool
+value_index_t::find_field_value_hash(const std::string& field_value, uint64_t& hash) const
+{
+	const value_index_item_t* best(nullptr);
+
+	if (nullptr == m_header || 0 == field_value.length())
+		return false;
+
+	/*
+	 * Values are stored in hash order; the data offset is kept so that the
+	 * first match in file order wins, as with a scan of the journal itself.
+	 */
+	for (uint64_t idx = 0; idx < n_values(); idx++) {
+		const value_index_item_t&	v(m_values[idx]);
+		const char*					payload(m_strings + v.string_offset);
+
+		if (nullptr != best && best->data_offset < v.data_offset)
+			continue;
+
+		for (uint64_t pos = 0; pos + field_value.length() <= v.string_size; pos++) {
+			if (! ::strncasecmp(field_value.c_str(), payload + pos, field_value.length())) {
+				best = &v;
+				break;
+			}
+		}
+	}
+
+	if (nullptr == best)
+		return false;
+
+	hash = best->hash;
+	return true;
+}
+
+const bool
+value_index_t::get_field_data_hashes(const std::string& field_name, std::vector< uint64_t >& hashes) const
+{
+	bool found(false);
+
+	if (nullptr == m_header || 0 == field_name.length())
+		return false;
+
+	/* names match regardless of case, as in input_journal_t::get_field_data_hashes() */
+	for (uint64_t idx = 0; idx < n_fields(); idx++) {
+		const field_index_item_t& f(m_fields[idx]);
+
+		if (f.string_size != field_name.length() || 0 != ::strncasecmp(field_name.c_str(), m_strings + f.string_offset, f.string_size))
+			continue;
+
+		for (uint64_t cnt = 0; cnt < f.n_values; cnt++)
+			hashes.push_back(m_values[m_field_values[f.values_offset + cnt]].hash);
+
+		found = true;
+	}
+
+	if (false == found)
+		return false;
+
+	std::sort(hashes.begin(), hashes.end());
+	hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+	return true;
+}
+
+const bool
+value_index_t::get_postings(const uint64_t hash, std::vector< uint64_t >& seqnums) const
+{
+	const value_index_item_t* v(find_hash(hash));
+
+	if (nullptr == v)
+		return false;
+
+	seqnums.insert(seqnums.end(), m_postings + v->postings_offset, m_postings + v->postings_offset + v->n_postings);
+	return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdio.h>
+#include <strings.h>
+
+#include "global.hpp"
+#include "file.hpp"
+#include "exception.hpp"
+#include "object.hpp"
+#include "journal.hpp"
+#include "cursor.hpp"
+#include "filter.hpp"
+#include "endian.hpp"
+#include "intstring.hpp"
+#include "log.hpp"
+
+#define VALUE_INDEX_SIGNATURE 	"ZAPVIDX1"
+#define VALUE_INDEX_SUFFIX 		".zapvidx"
+
+/*
+ * On-disk layout of the inverted index, all little endian:
+ *
+ *  value_index_header_t
+ *  value_index_item_t[n_values]		sorted by DATA hash
+ *  field_index_item_t[n_fields]		sorted by FIELD hash
+ *  uint64_t postings[n_postings]		entry seqnums, sorted per value
+ *  uint64_t field_values[n_field_values]	value indices, per field
+ *  char strings[strings_size]			payloads and field names
+ *
+ * file_id and tail_entry_seqnum identify the journal the index belongs to;
+ * any change to either invalidates it.
+ */
+typedef struct {
+	uint8_t		signature[8];
+	uint64_t	file_id[2];
+	uint64_t	tail_entry_seqnum;
+	uint64_t	n_values;
+	uint64_t	n_fields;
+	uint64_t	n_postings;
+	uint64_t	n_field_values;
+	uint64_t	strings_size;
+} value_index_header_t;
+
+typedef struct {
+	uint64_t	hash;
+	uint64_t	data_offset;
+	uint64_t	postings_offset;
+	uint64_t	n_postings;
+	uint64_t	string_offset;
+	uint64_t	string_size;
+} value_index_item_t;
+
+typedef struct {
+	uint64_t	hash;
+	uint64_t	values_offset;
+	uint64_t	n_values;
+	uint64_t	string_offset;
+	uint64_t	string_size;
+} field_index_item_t;
+
+/*
+ * FIELD=VALUE hash to entry seqnum postings plus a field to values 
+ * dictionary, built once per journal and mapped by later runs so that
+ * selection criteria resolve without touching the journal itself.
+ */
+class value_index_t
+{
+	private:
+		value_index_t(const value_index_t&)				= delete;
+		value_index_t& operator=(const value_index_t&)	= delete;
+
+	protected:
+		uint8_t*						m_map;
+		std::size_t						m_map_size;
+		const value_index_header_t*		m_header;
+		const value_index_item_t*		m_values;
+		const field_index_item_t*		m_fields;
+		const uint64_t*					m_postings;
+		const uint64_t*					m_field_values;
+		const char*						m_strings;
+
+		virtual const value_index_item_t* find_hash(const uint64_t) const;
+
+	public:
+		value_index_t(void);
+		virtual ~value_index_t(void);
+
+		virtual void reset(void);
+
+		virtual bool load(const std::string&, const uint128_vec_t&, const uint64_t);
+		static bool build(const std::string&, const journal_base_t&);
+
+		virtual const uint64_t n_values(void) const;
+		virtual const uint64_t n_fields(void) const;
+
+		virtual const bool find_field_value_hash(const std::string&, uint64_t&) const;
+		virtual const bool get_field_data_hashes(const std::string&, std::vector< uint64_t >&) const;
+		virtual const bool get_postings(const uint64_t, std::vector< uint64_t >&) const;
+};